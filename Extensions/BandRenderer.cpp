@@ -0,0 +1,171 @@
+/***************************************************************************************
+** Code for the band renderer
+***************************************************************************************/
+
+// Processors where the band is sent with DMA
+#if (defined (ESP32_DMA) || defined (STM32_DMA)) && !defined (TFT_PARALLEL_8_BIT)
+  #define BAND_DMA
+#endif
+
+/***************************************************************************************
+** Function name:           TFT_eSPI_BandRenderer
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eSPI_BandRenderer::TFT_eSPI_BandRenderer(TFT_eSPI *tft)
+{
+  _tft     = tft;
+  _buffer  = nullptr;
+  _size    = 0;
+  _buffers = 0;
+  _swap    = true;
+}
+
+/***************************************************************************************
+** Function name:           ~TFT_eSPI_BandRenderer
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eSPI_BandRenderer::~TFT_eSPI_BandRenderer(void)
+{
+  deleteBands();
+}
+
+/***************************************************************************************
+** Function name:           createBands
+** Description:             Allocate the band buffers
+***************************************************************************************/
+bool TFT_eSPI_BandRenderer::createBands(int32_t w, int32_t h, uint8_t buffers)
+{
+  deleteBands();
+
+  if ((w < 1) || (h < 1) || (buffers < 1)) return false;
+  if (buffers > BAND_BUFFERS_MAX) buffers = BAND_BUFFERS_MAX;
+
+  // DMA needs the buffers in internal RAM, so PSRAM is not used
+  _buffer = (uint16_t*) malloc(buffers * w * h * sizeof(uint16_t));
+  if (!_buffer) return false;
+
+  _size    = w * h;
+  _buffers = buffers;
+  for (uint8_t i = 0; i < BAND_BUFFERS_MAX; i++) _fence[i] = 0;
+
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           deleteBands
+** Description:             Free the band buffers
+***************************************************************************************/
+void TFT_eSPI_BandRenderer::deleteBands(void)
+{
+  if (!_buffer) return;
+
+#ifdef BAND_DMA
+  // The last bands may still be in use by DMA
+  for (uint8_t i = 0; i < _buffers; i++) waitBand(i);
+#endif
+
+  free(_buffer);
+  _buffer  = nullptr;
+  _size    = 0;
+  _buffers = 0;
+}
+
+/***************************************************************************************
+** Function name:           setSwapBytes
+** Description:             Set if the bands are byte swapped before they are sent
+***************************************************************************************/
+void TFT_eSPI_BandRenderer::setSwapBytes(bool swap)
+{
+  _swap = swap;
+}
+
+/***************************************************************************************
+** Function name:           render
+** Description:             Render and push an area in bands
+***************************************************************************************/
+bool TFT_eSPI_BandRenderer::render(int32_t x, int32_t y, int32_t w, int32_t h, bandCallback callback, void *arg)
+{
+  if (!_buffer || !callback) return false;
+
+  // Clip to the screen, the callback is only asked for visible pixels
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if ((x + w) > _tft->width())  w = _tft->width()  - x;
+  if ((y + h) > _tft->height()) h = _tft->height() - y;
+
+  if ((w < 1) || (h < 1)) return true;
+
+  int32_t rows = _size / w; // Rows in each band
+  if (rows < 1) return false;
+
+  bool swap = _tft->getSwapBytes();
+  _tft->startWrite();
+
+  uint8_t band = 0;
+  for (int32_t by = y; by < y + h; by += rows) {
+    int32_t bh = min(rows, y + h - by);
+
+    // Render the band while DMA sends the bands in the other buffers
+    waitBand(band);
+    callback(_buffer + band * _size, x, by, w, bh, arg);
+    pushBand(band, x, by, w, bh);
+
+    if (++band >= _buffers) band = 0;
+  }
+
+  _tft->endWrite(); // Waits for the last band
+  _tft->setSwapBytes(swap);
+
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           pushBand
+** Description:             Send a rendered band to the TFT
+***************************************************************************************/
+void TFT_eSPI_BandRenderer::pushBand(uint8_t band, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+  uint16_t *buffer = _buffer + band * _size;
+
+#ifdef BAND_DMA
+  if (_tft->DMA_Enabled) {
+    // DMA sends the band in TFT byte order
+    if (_swap) _tft->swapPixels(buffer, buffer, w * h);
+  #ifdef ESP32_DMA
+    _fence[band] = _tft->queueImageDMA(x, y, w, h, buffer);
+    if (_fence[band]) return;
+    // Queue full, more buffers than DMA_QUEUE_BLOCKS
+    _tft->dmaWait();
+    _fence[band] = _tft->queueImageDMA(x, y, w, h, buffer);
+  #else
+    // Sent once the last band has gone
+    _tft->pushImageDMA(x, y, w, h, buffer, nullptr, true);
+  #endif
+    return;
+  }
+#endif
+
+  _tft->setSwapBytes(_swap);
+  _tft->pushImage(x, y, w, h, buffer);
+}
+
+/***************************************************************************************
+** Function name:           waitBand
+** Description:             Wait until DMA has finished with a band buffer
+***************************************************************************************/
+void TFT_eSPI_BandRenderer::waitBand(uint8_t band)
+{
+#ifdef BAND_DMA
+  if (!_tft->DMA_Enabled) return;
+  #ifdef ESP32_DMA
+    if (_fence[band]) _tft->dmaWaitFence(_fence[band]);
+    _fence[band] = 0;
+  #else
+    // pushImageDMA() waits for the last band to go before it starts the next, so
+    // only a single buffer can still be in use
+    if (_buffers == 1) while (_tft->dmaBusy());
+  #endif
+#else
+  (void)band;
+#endif
+}
@@ -0,0 +1,49 @@
+/***************************************************************************************
+// The following class renders an area of the screen in horizontal bands so animations
+// can be drawn without a full frame buffer. The sketch supplies a callback that draws
+// each band into a buffer; while DMA sends one band the next band is rendered into
+// another buffer. Without DMA the bands are pushed with pushImage().
+***************************************************************************************/
+
+// Maximum number of band buffers
+#ifndef BAND_BUFFERS_MAX
+  #define BAND_BUFFERS_MAX 4
+#endif
+
+// Band render callback, draws w x h pixels for the band with top left corner at x,y
+// (screen coordinates) into buffer. Pixel (x,y) is buffer[0], rows are w pixels long
+typedef void (*bandCallback)(uint16_t *buffer, int32_t x, int32_t y, int32_t w, int32_t h, void *arg);
+
+class TFT_eSPI_BandRenderer {
+
+ public:
+  TFT_eSPI_BandRenderer(TFT_eSPI *tft);
+  ~TFT_eSPI_BandRenderer(void);
+
+  // Create the band buffers, each holds w x h pixels. Narrower areas get more rows
+  // per band. Returns false if there is no RAM
+  bool     createBands(int32_t w, int32_t h, uint8_t buffers = 2);
+  void     deleteBands(void);
+
+  // If true (default) the callback draws normal colour values and the bands are byte
+  // swapped for the TFT, if false the callback draws in TFT byte order (as Sprites do)
+  void     setSwapBytes(bool swap);
+
+  // Render the area in bands, off screen pixels are not rendered. Must not be called
+  // between startWrite() and endWrite(), returns when the last band has been sent.
+  // Returns false if the bands are not created or a row does not fit in a band
+  bool     render(int32_t x, int32_t y, int32_t w, int32_t h, bandCallback callback, void *arg = nullptr);
+
+ private:
+  void     pushBand(uint8_t band, int32_t x, int32_t y, int32_t w, int32_t h);
+  void     waitBand(uint8_t band);        // Wait until the band buffer is free
+
+  TFT_eSPI *_tft;
+
+  uint16_t *_buffer;                      // Band buffers, one allocation
+  uint32_t _size;                         // Pixels in each band buffer
+  uint8_t  _buffers;                      // Number of band buffers
+  bool     _swap;
+
+  uint32_t _fence[BAND_BUFFERS_MAX];      // ESP32 DMA fence of the last band sent from each buffer
+};
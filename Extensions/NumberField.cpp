@@ -0,0 +1,271 @@
+/***************************************************************************************
+** Code for the numeric readout UI element
+***************************************************************************************/
+
+/***************************************************************************************
+** Function name:           TFT_eSPI_NumberField
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eSPI_NumberField::TFT_eSPI_NumberField(void)
+{
+  _gfx        = nullptr;
+  _x = _y     = 0;
+  _datum      = TL_DATUM;
+  _padding    = 0;
+  _fgcolor    = TFT_WHITE;
+  _bgcolor    = TFT_BLACK;
+  _font       = 0;
+  _digitWidth = 0;
+  _widthNext  = 0;
+  _cells      = 0;
+  for (uint8_t i = 0; i < NUMBER_FIELD_WIDTHS; i++) _widthChar[i] = 0;
+}
+
+/***************************************************************************************
+** Function name:           initNumberField
+** Description:             Set the TFT or Sprite, position, datum and padding
+***************************************************************************************/
+void TFT_eSPI_NumberField::initNumberField(TFT_eSPI *gfx, int32_t x, int32_t y, uint8_t datum, uint16_t padding)
+{
+  _gfx     = gfx;
+  _x       = x;
+  _y       = y;
+  _datum   = datum;
+  _padding = padding;
+  _font    = 0;
+  _cells   = 0; // Nothing drawn yet
+}
+
+/***************************************************************************************
+** Function name:           setTextColor
+** Description:             Set the text and background colours
+***************************************************************************************/
+void TFT_eSPI_NumberField::setTextColor(uint16_t fgcolor, uint16_t bgcolor)
+{
+  if ((fgcolor == _fgcolor) && (bgcolor == _bgcolor)) return;
+  _fgcolor = fgcolor;
+  _bgcolor = bgcolor;
+  _font = 0; // All cells must be drawn again
+}
+
+/***************************************************************************************
+** Function name:           redraw
+** Description:             Draw all cells at the next update
+***************************************************************************************/
+void TFT_eSPI_NumberField::redraw(void)
+{
+  _font = 0;
+}
+
+/***************************************************************************************
+** Function name:           drawNumber
+** Description:             Draw a long integer
+***************************************************************************************/
+int16_t TFT_eSPI_NumberField::drawNumber(long value)
+{
+  char str[12];
+  ltoa(value, str, 10);
+  return drawString(str);
+}
+
+/***************************************************************************************
+** Function name:           drawFloat
+** Description:             Draw a float, formatted the same way as TFT_eSPI::drawFloat()
+***************************************************************************************/
+int16_t TFT_eSPI_NumberField::drawFloat(float value, uint8_t dp)
+{
+  char str[14];
+  uint8_t ptr = 0;
+  int8_t  digits = 1;
+  float rounding = 0.5;
+
+  if (dp > 7) dp = 7;
+  for (uint8_t i = 0; i < dp; ++i) rounding /= 10.0;
+
+  if (value < -rounding) {
+    str[ptr++] = '-';
+    digits = 0;
+    value = -value;
+  }
+
+  value += rounding;
+
+  if (value >= 2147483647) return drawString("...");
+
+  uint32_t temp = (uint32_t)value;
+  ltoa(temp, str + ptr, 10);
+  while ((uint8_t)str[ptr] != 0) ptr++;
+  digits += ptr;
+
+  str[ptr++] = '.';
+  str[ptr] = '0';
+  str[ptr + 1] = 0;
+
+  value = value - temp;
+
+  uint8_t i = 0;
+  while ((i < dp) && (digits < 9)) {
+    i++;
+    value *= 10;
+    temp = value;
+    ltoa(temp, str + ptr, 10);
+    ptr++; digits++;
+    value -= temp;
+  }
+
+  return drawString(str);
+}
+
+/***************************************************************************************
+** Function name:           drawString
+** Description:             Draw the characters of a formatted number that have changed
+***************************************************************************************/
+int16_t TFT_eSPI_NumberField::drawString(const char *string)
+{
+  if (!_gfx) return 0;
+
+  // Cell widths depend on the font, so all cells are drawn if it has changed
+  uint32_t font = (_gfx->textfont << 24) ^ (_gfx->textsize << 16) ^ _gfx->fontHeight();
+  font ^= (uint32_t)_gfx->textWidth("0") << 8;
+#ifdef SMOOTH_FONT
+  if (_gfx->fontLoaded) font ^= 0x80000000UL;
+#endif
+  font |= 1; // 0 means redraw
+
+  bool all = (font != _font);
+  if (all) {
+    _font = font;
+    _digitWidth = 0;
+    for (char c = '0'; c <= '9'; c++) {
+      int16_t w = advance(c);
+      if (w > _digitWidth) _digitWidth = w;
+    }
+    for (uint8_t i = 0; i < NUMBER_FIELD_WIDTHS; i++) _widthChar[i] = 0;
+  }
+
+  // Lay out the new cells, cell 0 and the last cell are the padding each side
+  numberCell_t cell[NUMBER_FIELD_MAX + 2];
+  uint8_t cells = 1;
+  int32_t sw = 0; // String width
+  while (*string && (cells <= NUMBER_FIELD_MAX)) {
+    char c = *string++;
+    cell[cells].c = c;
+    cell[cells].w = cellWidth(c);
+    sw += cell[cells].w;
+    cells++;
+  }
+
+  // Position the string and padding relative to the datum, as drawString() does
+  int32_t pad = (_padding > sw) ? _padding - sw : 0;
+  int32_t sx = _x;
+  int16_t padL = 0;
+  switch (_datum % 3) {
+    case 1: sx -= sw / 2; padL = pad / 2; break; // Centre
+    case 2: sx -= sw;     padL = pad;     break; // Right
+  }
+
+  cell[0].x = sx - padL;
+  cell[0].w = padL;
+  cell[0].c = 0;
+
+  int32_t cx = sx;
+  for (uint8_t i = 1; i < cells; i++) {
+    cell[i].x = cx;
+    cx += cell[i].w;
+  }
+
+  cell[cells].x = cx;
+  cell[cells].w = pad - padL;
+  cell[cells].c = 0;
+  cells++;
+
+  uint8_t  tempdatum   = _gfx->getTextDatum();
+  uint16_t tempPadding = _gfx->padX;
+  uint32_t tempColor   = _gfx->textcolor;
+  uint32_t tempBgColor = _gfx->textbgcolor;
+  _gfx->setTextDatum(_datum - _datum % 3); // Cells are drawn from their left edge
+  _gfx->setTextColor(_fgcolor, _bgcolor);
+
+  // Clear the area drawn last time that the new cells do not cover
+  if (_cells) {
+    numberCell_t clear;
+    clear.c = 0;
+
+    int32_t oldL = _cell[0].x;
+    int32_t oldR = _cell[_cells - 1].x + _cell[_cells - 1].w;
+    int32_t newL = cell[0].x;
+    int32_t newR = cell[cells - 1].x + cell[cells - 1].w;
+
+    if (oldL < newL) { clear.x = oldL; clear.w = min(oldR, newL) - oldL; drawCell(&clear); }
+    if (oldR > newR) { clear.x = max(oldL, newR); clear.w = oldR - clear.x; drawCell(&clear); }
+  }
+
+  // Draw the cells that differ from the cell drawn at the same place last time
+  for (uint8_t i = 0; i < cells; i++) {
+    if (cell[i].w <= 0) continue;
+
+    if (!all) {
+      uint8_t j = 0;
+      while ((j < _cells) && ((_cell[j].x != cell[i].x) || (_cell[j].w != cell[i].w) || (_cell[j].c != cell[i].c))) j++;
+      if (j < _cells) continue;
+    }
+
+    drawCell(&cell[i]);
+  }
+
+  memcpy(_cell, cell, cells * sizeof(numberCell_t));
+  _cells = cells;
+
+  _gfx->setTextDatum(tempdatum);
+  _gfx->setTextPadding(tempPadding);
+  _gfx->setTextColor(tempColor, tempBgColor);
+
+  return sw;
+}
+
+/***************************************************************************************
+** Function name:           advance
+** Description:             Return the cell width for a character
+***************************************************************************************/
+int16_t TFT_eSPI_NumberField::advance(char c)
+{
+  // The width of a string ends at the last glyph pixel, so measure against a following
+  // digit to get the full advance of the character
+  char str[3] = { c, '0', 0 };
+  return _gfx->textWidth(str) - _gfx->textWidth("0");
+}
+
+/***************************************************************************************
+** Function name:           cellWidth
+** Description:             Return the cell width for a character, measuring it only once
+***************************************************************************************/
+int16_t TFT_eSPI_NumberField::cellWidth(char c)
+{
+  if ((c >= '0') && (c <= '9')) return _digitWidth;
+
+  for (uint8_t i = 0; i < NUMBER_FIELD_WIDTHS; i++) if (_widthChar[i] == c) return _width[i];
+
+  int16_t w = advance(c);
+
+  _widthChar[_widthNext] = c;
+  _width[_widthNext] = w;
+  if (++_widthNext >= NUMBER_FIELD_WIDTHS) _widthNext = 0;
+
+  return w;
+}
+
+/***************************************************************************************
+** Function name:           drawCell
+** Description:             Draw a character, or clear a padding cell, using padding
+***************************************************************************************/
+void TFT_eSPI_NumberField::drawCell(const numberCell_t *cell)
+{
+  char str[2] = { cell->c, 0 };
+
+  // Padding cells are cleared by drawing a zero width string padded to the cell width,
+  // GFX free fonts only fill the padding if the string holds a glyph (space is zero width)
+  if (!cell->c && (_gfx->textWidth(" ") == 0)) str[0] = ' ';
+
+  _gfx->setTextPadding(cell->w);
+  _gfx->drawString(str, cell->x, _y);
+}
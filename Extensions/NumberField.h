@@ -0,0 +1,65 @@
+/***************************************************************************************
+// The following class creates a numeric readout that remembers the characters drawn
+// and only redraws the character cells that change. Digits are drawn in fixed width
+// cells (the widest digit) so the digits do not move as the value changes.
+// The text datum and padding work the same way as drawNumber() and drawString().
+// A background colour is needed so changed cells can be cleared.
+***************************************************************************************/
+
+// Maximum number of characters in the field
+#ifndef NUMBER_FIELD_MAX
+  #define NUMBER_FIELD_MAX 16
+#endif
+
+// Number of non-digit cell widths kept (e.g. '-' and '.'), so they are not measured each update
+#ifndef NUMBER_FIELD_WIDTHS
+  #define NUMBER_FIELD_WIDTHS 4
+#endif
+
+class TFT_eSPI_NumberField {
+
+ public:
+  TFT_eSPI_NumberField(void);
+
+  // Field reference point x,y, datum and padding as used by drawString()
+  void     initNumberField(TFT_eSPI *gfx, int32_t x, int32_t y, uint8_t datum = TL_DATUM, uint16_t padding = 0);
+
+  void     setTextColor(uint16_t fgcolor, uint16_t bgcolor);
+
+  // Draw the changed characters, returns pixel width of the string
+  int16_t  drawNumber(long value);
+  int16_t  drawFloat(float value, uint8_t dp);
+  int16_t  drawString(const char *string);
+
+  // Draw all the characters at the next update (e.g. after the screen is cleared)
+  void     redraw(void);
+
+ private:
+  typedef struct
+  {
+    int16_t  x;                   // Cell left edge
+    int16_t  w;                   // Cell width
+    char     c;                   // Character, 0 for padding
+  } numberCell_t;
+
+  int16_t  advance(char c);       // Measure the cell width for a character
+  int16_t  cellWidth(char c);     // Cell width for a character, measured once per font
+  void     drawCell(const numberCell_t *cell);
+
+  TFT_eSPI *_gfx;
+
+  int32_t  _x, _y;
+  uint8_t  _datum;
+  uint16_t _padding;
+  uint16_t _fgcolor, _bgcolor;
+
+  uint32_t _font;                 // Identifies the font and size the cells were drawn with
+  int16_t  _digitWidth;           // Width of a digit cell
+
+  char     _widthChar[NUMBER_FIELD_WIDTHS]; // Non-digit characters measured, 0 if unused
+  int16_t  _width[NUMBER_FIELD_WIDTHS];     // and their cell widths
+  uint8_t  _widthNext;            // Entry replaced next
+
+  numberCell_t _cell[NUMBER_FIELD_MAX + 2]; // Cells drawn, including padding each side
+  uint8_t  _cells;
+};
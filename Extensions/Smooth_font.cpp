@@ -13,10 +13,95 @@
 void TFT_eSPI::loadFont(const uint8_t array[])
 {
   if (array == nullptr) return;
+
+  // Check for a font atlas created by the Create_atlas Processing sketch
+  if ((pgm_read_byte(array) == 'T') && (pgm_read_byte(array + 1) == 'F') && (pgm_read_byte(array + 2) == 'A'))
+  {
+    loadAtlas(array);
+    return;
+  }
+
   fontPtr = (uint8_t*) array;
   loadFont("", false);
 }
 
+
+/***************************************************************************************
+** Function name:           loadAtlas
+** Description:             Use a font atlas array in place, no parsing or copying needed
+*************************************************************************************x*/
+void TFT_eSPI::loadAtlas(const uint8_t array[])
+{
+  /*
+    The font atlas is created from a vlw file by the Create_atlas Processing sketch in
+    the Tools folder. Values are little endian and the array must be 4 byte aligned.
+
+    Header comprises 24 bytes:
+      0  uint8_t  "TFA" identifier
+      3  uint8_t  Bits per alpha value, 8 or 4
+      4  uint16_t gCount
+      6  uint16_t yAdvance
+      8  uint16_t spaceWidth
+      10 int16_t  ascent
+      12 int16_t  descent
+      14 uint16_t maxAscent
+      16 uint16_t maxDescent
+      18 uint16_t reserved
+      20 uint32_t total array size in bytes
+
+    Next are the glyph metrics, each an array of gCount values:
+      uint32_t gBitmap   offset of glyph bitmap from the start of the array
+      uint16_t gUnicode  in ascending order
+      int16_t  gdY
+      uint8_t  gHeight
+      uint8_t  gWidth
+      uint8_t  gxAdvance
+      int8_t   gdX
+
+    The glyph bitmaps follow. For 4 bit alpha the first pixel is in the top 4 bits of a
+    byte and each row starts on a new byte.
+  */
+
+  if (fontLoaded) unloadFont();
+
+#ifdef FONT_FS_AVAILABLE
+  fs_font = false;
+#endif
+
+  gFont.gArray     = array;
+  gAlphaBits       = pgm_read_byte(array + 3);
+  gFont.gCount     = pgm_read_word(array + 4);
+  gFont.yAdvance   = pgm_read_word(array + 6);
+  gFont.spaceWidth = pgm_read_word(array + 8);
+  gFont.ascent     = (int16_t)pgm_read_word(array + 10);
+  gFont.descent    = (int16_t)pgm_read_word(array + 12);
+  gFont.maxAscent  = pgm_read_word(array + 14);
+  gFont.maxDescent = pgm_read_word(array + 16);
+
+  const uint8_t* metrics = array + 24;
+
+#if defined (ESP8266)
+  // Flash is not byte addressable on the ESP8266 so the metrics must be copied to RAM
+  gMetrics = (uint8_t*)malloc(gFont.gCount * 12);
+  if (!gMetrics) return;
+  memcpy_P(gMetrics, metrics, gFont.gCount * 12);
+  metrics = gMetrics;
+#endif
+
+  gBitmap   = (uint32_t*)metrics; metrics += gFont.gCount * 4;
+  gUnicode  = (uint16_t*)metrics; metrics += gFont.gCount * 2;
+  gdY       =  (int16_t*)metrics; metrics += gFont.gCount * 2;
+  gHeight   =  (uint8_t*)metrics; metrics += gFont.gCount;
+  gWidth    =  (uint8_t*)metrics; metrics += gFont.gCount;
+  gxAdvance =  (uint8_t*)metrics; metrics += gFont.gCount;
+  gdX       =   (int8_t*)metrics;
+
+  fontInPlace = true;
+  fontLoaded  = true;
+
+  buildGlyphIndex(); // Codes are in order so no RAM is allocated
+}
+
 #ifdef FONT_FS_AVAILABLE
 /***************************************************************************************
 ** Function name:           loadFont
@@ -126,7 +211,7 @@ void TFT_eSPI::loadFont(String fontName, bool flash)
   gFont.gArray   = (const uint8_t*)fontPtr;
 
   gFont.gCount   = (uint16_t)readInt32(); // glyph count in file
-                             readInt32(); // vlw encoder version - discard
+  gKernTable     = (readInt32() == 12);   // vlw encoder version, 12 if a kerning table follows
   gFont.yAdvance = (uint16_t)readInt32(); // Font size in points, not pixels
                              readInt32(); // discard
   gFont.ascent   = (uint16_t)readInt32(); // top of "d"
@@ -245,6 +330,157 @@ void TFT_eSPI::loadMetrics(void)
   gFont.yAdvance = gFont.maxAscent + gFont.maxDescent;
 
   gFont.spaceWidth = (gFont.ascent + gFont.descent) * 2/7;  // Guess at space width
+
+  buildGlyphIndex();
+
+  if (gKernTable) loadKerning(bitmapPtr);
+}
+
+
+/***************************************************************************************
+** Function name:           loadKerning
+** Description:             Load kerning pairs appended to the vlw file, if present
+*************************************************************************************x*/
+// Sort keys hold the left Unicode code in the top 16 bits and the right in the bottom
+static int kernPairCompare(const void *a, const void *b)
+{
+  uint32_t ka = ((const TFT_eSPI::kernPair_t*)a)->key;
+  uint32_t kb = ((const TFT_eSPI::kernPair_t*)b)->key;
+  return (ka > kb) - (ka < kb);
+}
+
+void TFT_eSPI::loadKerning(uint32_t filePtr)
+{
+  /*
+    The vlw file ends with two strings (16 bit length followed by the characters) giving
+    the font name and Postscript name, then 1 byte for the smooth flag. The Create_font
+    Processing sketch can then append a kerning table, and sets the vlw version to 12:
+      1. "KERN" identifier
+      2. Number of kerning pairs
+      Next are the pairs, each comprises 2 int32t parameters (8 bytes):
+      1. Left Unicode code in top 16 bits, right Unicode code in bottom 16 bits
+      2. Adjustment to the cursor advance in pixels between the two glyphs (signed)
+  */
+
+  // The end of an array is not known, but a file must not be read past its end
+  uint32_t fileSize = 0xFFFFFFFF;
+#ifdef FONT_FS_AVAILABLE
+  if (fs_font) fileSize = fontFile.size();
+#endif
+
+  // Skip the name strings and smooth flag
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    uint16_t len = 0;
+    if (filePtr + 2 > fileSize) return;
+#ifdef FONT_FS_AVAILABLE
+    if (fs_font)
+    {
+      fontFile.seek(filePtr, fs::SeekSet);
+      len = fontFile.read() << 8;
+      len |= fontFile.read();
+    }
+    else
+#endif
+    {
+      len = pgm_read_byte(gFont.gArray + filePtr) << 8;
+      len |= pgm_read_byte(gFont.gArray + filePtr + 1);
+    }
+    filePtr += 2 + len;
+  }
+  filePtr++;
+
+  if (filePtr + 8 > fileSize) return;
+
+#ifdef FONT_FS_AVAILABLE
+  if (fs_font) fontFile.seek(filePtr, fs::SeekSet);
+  else
+#endif
+  fontPtr = (uint8_t*)gFont.gArray + filePtr;
+
+  if (readInt32() != 0x4B45524E) return; // "KERN"
+
+  uint32_t count = readInt32();
+  if ((count == 0) || (count > 0xFFFF) || (filePtr + 8 + count * 8 > fileSize)) return;
+
+  gKern = (kernPair_t*)malloc(count * sizeof(kernPair_t));
+  if (!gKern) return;
+
+  for (uint32_t i = 0; i < count; i++)
+  {
+    gKern[i].key    = readInt32();
+    gKern[i].adjust = (int8_t)readInt32();
+    yield();
+  }
+
+  qsort(gKern, count, sizeof(kernPair_t), kernPairCompare);
+  gKernCount = count;
+}
+
+
+/***************************************************************************************
+** Function name:           buildGlyphIndex
+** Description:             Create the index used by getUnicodeIndex()
+*************************************************************************************x*/
+// Sort keys hold the Unicode code in the top 16 bits and the glyph number in the bottom
+static int glyphKeyCompare(const void *a, const void *b)
+{
+  uint32_t ka = *(const uint32_t*)a;
+  uint32_t kb = *(const uint32_t*)b;
+  return (ka > kb) - (ka < kb);
+}
+
+void TFT_eSPI::buildGlyphIndex(void)
+{
+  gOrdered    = true;
+  gDenseFirst = 0;
+  gDenseIndex = 0;
+  gDenseCount = 0;
+
+  // Find the longest run of consecutive codes and check if the codes are in order
+  uint16_t runStart = 0;
+  for (uint32_t gNum = 1; gNum <= gFont.gCount; gNum++)
+  {
+    if ((gNum == gFont.gCount) || (gUnicode[gNum] != gUnicode[gNum - 1] + 1))
+    {
+      if (gNum - runStart > gDenseCount)
+      {
+        gDenseFirst = gUnicode[runStart];
+        gDenseIndex = runStart;
+        gDenseCount = gNum - runStart;
+      }
+      runStart = gNum;
+    }
+    if ((gNum < gFont.gCount) && (gUnicode[gNum] <= gUnicode[gNum - 1])) gOrdered = false;
+  }
+
+  // Codes in order can be binary searched without an index
+  if (gOrdered) return;
+
+#if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
+  if ( psramFound() ) gSorted = (uint16_t*)ps_malloc( gFont.gCount * 2);
+  else
+#endif
+  gSorted = (uint16_t*)malloc( gFont.gCount * 2);
+
+  uint32_t* key = (uint32_t*)malloc( gFont.gCount * 4);
+
+  // Without an index getUnicodeIndex() searches all the codes
+  if (!gSorted || !key)
+  {
+    if (gSorted) free(gSorted);
+    if (key) free(key);
+    gSorted = NULL;
+    return;
+  }
+
+  for (uint16_t gNum = 0; gNum < gFont.gCount; gNum++) key[gNum] = (uint32_t)gUnicode[gNum] << 16 | gNum;
+
+  qsort(key, gFont.gCount, sizeof(uint32_t), glyphKeyCompare);
+
+  for (uint16_t gNum = 0; gNum < gFont.gCount; gNum++) gSorted[gNum] = (uint16_t)key[gNum];
+
+  free(key);
 }
 
 
@@ -254,6 +490,18 @@ void TFT_eSPI::loadMetrics(void)
 *************************************************************************************x*/
 void TFT_eSPI::unloadFont( void )
 {
+  if (fontInPlace)
+  {
+    // Metrics are in the font atlas, or in one block of RAM
+    if (gMetrics) free(gMetrics);
+    gMetrics = nullptr;
+    gUnicode = NULL; gHeight = NULL; gWidth = NULL; gxAdvance = NULL;
+    gdY = NULL; gdX = NULL; gBitmap = NULL;
+    fontInPlace = false;
+  }
+
+  gAlphaBits = 8;
+
   if (gUnicode)
   {
     free(gUnicode);
@@ -296,9 +544,29 @@ void TFT_eSPI::unloadFont( void )
     gBitmap = NULL;
   }
 
+  if (gSorted)
+  {
+    free(gSorted);
+    gSorted = NULL;
+  }
+
+  gDenseCount = 0;
+
+  if (gKern)
+  {
+    free(gKern);
+    gKern = nullptr;
+  }
+
+  gKernCount = 0;
+
+  clearLayoutCache();
+
   gFont.gArray = nullptr;
 
 #ifdef FONT_FS_AVAILABLE
+  clearGlyphCache();
+
   if (fs_font && fontFile) fontFile.close();
 #endif
 
@@ -340,6 +608,34 @@ uint32_t TFT_eSPI::readInt32(void)
 *************************************************************************************x*/
 bool TFT_eSPI::getUnicodeIndex(uint16_t unicode, uint16_t *index)
 {
+  // Direct lookup for the longest run of consecutive codes, typically ASCII
+  uint16_t offset = unicode - gDenseFirst;
+  if (offset < gDenseCount)
+  {
+    *index = gDenseIndex + offset;
+    return true;
+  }
+
+  // Binary search of the codes in order
+  if (gOrdered || gSorted)
+  {
+    int32_t lo = 0;
+    int32_t hi = gFont.gCount - 1;
+    while (lo <= hi)
+    {
+      int32_t  mid = (lo + hi) >> 1;
+      uint16_t i   = gSorted ? gSorted[mid] : mid;
+      if (gUnicode[i] == unicode)
+      {
+        *index = i;
+        return true;
+      }
+      if (gUnicode[i] < unicode) lo = mid + 1;
+      else hi = mid - 1;
+    }
+    return false;
+  }
+
   for (uint16_t i = 0; i < gFont.gCount; i++)
   {
     if (gUnicode[i] == unicode)
@@ -352,6 +648,373 @@ bool TFT_eSPI::getUnicodeIndex(uint16_t unicode, uint16_t *index)
 }
 
 
+/***************************************************************************************
+** Function name:           getGlyphIndexSize
+** Description:             Return the RAM in bytes used by the glyph lookup index
+*************************************************************************************x*/
+uint32_t TFT_eSPI::getGlyphIndexSize(void)
+{
+  if (gSorted) return gFont.gCount * 2;
+
+  return 0; // Codes in file order and the consecutive run are searched in place
+}
+
+
+/***************************************************************************************
+** Function name:           setGlyphCacheSize
+** Description:             Set the RAM budget for cached glyph bitmaps, 0 = no cache
+*************************************************************************************x*/
+void TFT_eSPI::setGlyphCacheSize(uint32_t bytes)
+{
+#ifdef FONT_FS_AVAILABLE
+  clearGlyphCache();
+  gCacheSize = bytes;
+#else
+  bytes = bytes; // Avoid unused variable warning, font arrays are already in memory
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           setFontReadBack
+** Description:             Blend transparent smooth font text with the screen content
+*************************************************************************************x*/
+// The TFT must support reads (RAMRD), e.g. TFT_MISO must be connected for SPI displays
+void TFT_eSPI::setFontReadBack(bool state)
+{
+  fontReadBack = state;
+}
+
+
+/***************************************************************************************
+** Function name:           preloadGlyphs
+** Description:             Read the glyphs used in a UTF-8 string into the cache
+*************************************************************************************x*/
+void TFT_eSPI::preloadGlyphs(const char *utf8)
+{
+#ifdef FONT_FS_AVAILABLE
+  if (!fontLoaded || !fs_font || !utf8) return;
+
+  uint16_t len = strlen(utf8);
+  uint16_t n = 0;
+
+  while (n < len)
+  {
+    uint16_t gNum = 0;
+    uint16_t unicode = decodeUTF8((uint8_t*)utf8, &n, len - n);
+    if (getUnicodeIndex(unicode, &gNum)) getCachedGlyph(gNum);
+  }
+#else
+  utf8 = utf8; // Avoid unused variable warning, font arrays are already in memory
+#endif
+}
+
+
+#ifdef FONT_FS_AVAILABLE
+/***************************************************************************************
+** Function name:           getCachedGlyph
+** Description:             Return the glyph bitmap from the cache, reading it if needed
+*************************************************************************************x*/
+// Returns nullptr if the glyph cannot be cached, the caller must then read the file
+const uint8_t* TFT_eSPI::getCachedGlyph(uint16_t gNum)
+{
+  uint32_t size = gWidth[gNum] * gHeight[gNum];
+
+  if (!fs_font || !size || (size > gCacheSize)) return nullptr;
+
+  if (!gCache)
+  {
+    gCache = (glyphCache_t*)calloc(GLYPH_CACHE_ENTRIES, sizeof(glyphCache_t));
+    if (!gCache) return nullptr;
+  }
+
+  gCacheTick++;
+
+  // Look for the glyph, also find an empty or the least recently used entry
+  uint16_t lru = 0;
+  for (uint16_t i = 0; i < GLYPH_CACHE_ENTRIES; i++)
+  {
+    if (gCache[i].bitmap && (gCache[i].gNum == gNum))
+    {
+      gCache[i].used = gCacheTick;
+      return gCache[i].bitmap;
+    }
+    if (gCache[lru].bitmap && (!gCache[i].bitmap || (gCache[i].used < gCache[lru].used))) lru = i;
+  }
+
+  if (gCache[lru].bitmap)
+  {
+    gCacheUsed -= gWidth[gCache[lru].gNum] * gHeight[gCache[lru].gNum];
+    free(gCache[lru].bitmap);
+    gCache[lru].bitmap = nullptr;
+  }
+
+  // Free the oldest bitmaps until the new one fits in the budget
+  while (gCacheUsed + size > gCacheSize)
+  {
+    uint16_t old = lru;
+    for (uint16_t i = 0; i < GLYPH_CACHE_ENTRIES; i++)
+    {
+      if (gCache[i].bitmap && (!gCache[old].bitmap || (gCache[i].used < gCache[old].used))) old = i;
+    }
+    gCacheUsed -= gWidth[gCache[old].gNum] * gHeight[gCache[old].gNum];
+    free(gCache[old].bitmap);
+    gCache[old].bitmap = nullptr;
+  }
+
+  uint8_t* bitmap;
+#if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
+  if ( psramFound() ) bitmap = (uint8_t*)ps_malloc(size);
+  else
+#endif
+  bitmap = (uint8_t*)malloc(size);
+
+  if (!bitmap) return nullptr;
+
+  // Whole bitmap is read in one go, a short read is not cached
+  fontFile.seek(gBitmap[gNum], fs::SeekSet);
+  if (fontFile.read(bitmap, size) != size)
+  {
+    free(bitmap);
+    return nullptr;
+  }
+
+  gCache[lru].bitmap = bitmap;
+  gCache[lru].used   = gCacheTick;
+  gCache[lru].gNum   = gNum;
+  gCacheUsed += size;
+
+  return bitmap;
+}
+
+
+/***************************************************************************************
+** Function name:           clearGlyphCache
+** Description:             Free all the cached glyph bitmaps
+*************************************************************************************x*/
+void TFT_eSPI::clearGlyphCache(void)
+{
+  if (gCache)
+  {
+    for (uint16_t i = 0; i < GLYPH_CACHE_ENTRIES; i++) if (gCache[i].bitmap) free(gCache[i].bitmap);
+    free(gCache);
+    gCache = nullptr;
+  }
+
+  gCacheUsed = 0;
+}
+#endif
+
+
+/***************************************************************************************
+** Function name:           getGlyphAlpha
+** Description:             Read a glyph pixel alpha value from the font array
+*************************************************************************************x*/
+uint8_t TFT_eSPI::getGlyphAlpha(uint16_t gNum, int32_t x, int32_t y)
+{
+  const uint8_t* bitmap = gFont.gArray + gBitmap[gNum];
+
+  if (gAlphaBits == 8) return pgm_read_byte(bitmap + x + gWidth[gNum] * y);
+
+  // 4 bit alpha, scale 0x0 - 0xF to 0x00 - 0xFF
+  uint8_t alpha = pgm_read_byte(bitmap + (x >> 1) + ((gWidth[gNum] + 1) >> 1) * y);
+  if (x & 1) return (alpha & 0x0F) * 0x11;
+  return (alpha >> 4) * 0x11;
+}
+
+
+/***************************************************************************************
+** Function name:           setKerning
+** Description:             Enable or disable kerning when text strings are laid out
+*************************************************************************************x*/
+void TFT_eSPI::setKerning(bool state)
+{
+  gKerning = state;
+  clearLayoutCache();
+}
+
+
+/***************************************************************************************
+** Function name:           setLigatures
+** Description:             Enable or disable Latin ligatures (ff, fi, fl, ffi, ffl)
+*************************************************************************************x*/
+// Ligatures are only used if the font contains the ligature glyph (0xFB00 - 0xFB04)
+void TFT_eSPI::setLigatures(bool state)
+{
+  gLigatures = state;
+  clearLayoutCache();
+}
+
+
+/***************************************************************************************
+** Function name:           getKerning
+** Description:             Return the kerning adjustment between two glyphs
+*************************************************************************************x*/
+int8_t TFT_eSPI::getKerning(uint16_t left, uint16_t right)
+{
+  if (!gKerning || !gKernCount) return 0;
+
+  uint32_t key = (uint32_t)left << 16 | right;
+  int32_t lo = 0, hi = gKernCount - 1;
+
+  while (lo <= hi)
+  {
+    int32_t mid = (lo + hi) >> 1;
+    if (gKern[mid].key == key) return gKern[mid].adjust;
+    if (gKern[mid].key < key) lo = mid + 1;
+    else hi = mid - 1;
+  }
+
+  return 0;
+}
+
+
+/***************************************************************************************
+** Function name:           layoutString
+** Description:             Shape a UTF-8 string into a run of glyphs, returns cached run
+*************************************************************************************x*/
+// Ligature sequences, longest first, and the ligature code
+static const uint16_t smoothLigatures[][4] = {
+  { 'f', 'f', 'i', 0xFB03 },
+  { 'f', 'f', 'l', 0xFB04 },
+  { 'f', 'f',  0 , 0xFB00 },
+  { 'f', 'i',  0 , 0xFB01 },
+  { 'f', 'l',  0 , 0xFB02 },
+};
+
+const TFT_eSPI::textLayout_t* TFT_eSPI::layoutString(const char *string)
+{
+  if (!fontLoaded || !string) return nullptr;
+
+  if (!gLayout)
+  {
+    gLayout = (textLayout_t*)calloc(LAYOUT_CACHE_ENTRIES, sizeof(textLayout_t));
+    if (!gLayout) return nullptr;
+  }
+
+  gLayoutTick++;
+
+  // Return the run if the string has been laid out already, else replace the oldest run
+  textLayout_t* layout = nullptr;
+  for (uint16_t i = 0; i < LAYOUT_CACHE_ENTRIES; i++)
+  {
+    textLayout_t* entry = gLayout + i;
+    if (entry->text && (entry->digits == isDigits) && !strcmp(entry->text, string))
+    {
+      entry->used = gLayoutTick;
+      if (_pinWidth) entry->pinned = true;
+      return entry;
+    }
+    if (!entry->pinned && (!layout || (entry->used < layout->used))) layout = entry;
+  }
+
+  if (!layout) return nullptr; // All runs are kept by cacheTextWidth()
+
+  // The run and a copy of the string are held in one block of RAM, there are no more
+  // glyphs than bytes so the block is sized by the string length. The block is reused
+  // if the string fits
+  uint16_t len = strlen(string);
+  if (!layout->glyph || (len > layout->size))
+  {
+    if (layout->glyph) free(layout->glyph);
+    layout->text  = nullptr;
+    layout->glyph = (shapedGlyph_t*)malloc(len * sizeof(shapedGlyph_t) + len + 1);
+    if (!layout->glyph) { layout->size = 0; return nullptr; }
+    layout->size  = len;
+  }
+
+  shapedGlyph_t* glyph = layout->glyph;
+  layout->text = (char*)(glyph + layout->size);
+  strcpy(layout->text, string);
+
+  // Decode the string once
+  uint16_t count = 0;
+  uint16_t n = 0;
+
+  while (n < len)
+  {
+    uint16_t uniCode = decodeUTF8((uint8_t*)string, &n, len - n);
+
+    if (gLigatures && (uniCode == 'f'))
+    {
+      uint16_t gNum = 0;
+      for (uint8_t l = 0; l < sizeof(smoothLigatures) / sizeof(smoothLigatures[0]); l++)
+      {
+        uint8_t m = (smoothLigatures[l][2] == 0) ? 1 : 2; // Characters after the 'f'
+        if ((n + m <= len) && (string[n] == smoothLigatures[l][1]) && ((m == 1) || (string[n + 1] == smoothLigatures[l][2]))
+            && getUnicodeIndex(smoothLigatures[l][3], &gNum))
+        {
+          uniCode = smoothLigatures[l][3];
+          n += m;
+          break;
+        }
+      }
+    }
+
+    glyph[count++].code = uniCode;
+  }
+
+  // Position the glyphs, width is measured the same way as the original textWidth()
+  int32_t  width = 0;
+  uint16_t last  = 0; // Previous glyph code for kerning
+
+  for (uint16_t i = 0; i < count; i++)
+  {
+    uint16_t code = glyph[i].code;
+    int8_t   kern = 0;
+
+    if (code == 0x20)
+    {
+      width += gFont.spaceWidth;
+      last = 0;
+    }
+    else
+    {
+      uint16_t gNum = 0;
+      if (getUnicodeIndex(code, &gNum))
+      {
+        if (last) kern = getKerning(last, code);
+        width += kern;
+        if (width == 0 && gdX[gNum] < 0) width -= gdX[gNum];
+        if ((i < count - 1) || isDigits) width += gxAdvance[gNum];
+        else width += (gdX[gNum] + gWidth[gNum]);
+        last = code;
+      }
+      else
+      {
+        width += gFont.spaceWidth + 1;
+        last = 0;
+      }
+    }
+
+    glyph[i].kern = kern;
+  }
+
+  layout->count  = count;
+  layout->width  = width;
+  layout->digits = isDigits;
+  layout->used   = gLayoutTick;
+  layout->pinned = _pinWidth;
+
+  return layout;
+}
+
+
+/***************************************************************************************
+** Function name:           clearLayoutCache
+** Description:             Free the cached text runs
+*************************************************************************************x*/
+void TFT_eSPI::clearLayoutCache(void)
+{
+  if (gLayout)
+  {
+    for (uint16_t i = 0; i < LAYOUT_CACHE_ENTRIES; i++) if (gLayout[i].glyph) free(gLayout[i].glyph);
+    free(gLayout);
+    gLayout = nullptr;
+  }
+}
+
+
 /***************************************************************************************
 ** Function name:           drawGlyph
 ** Description:             Write a character to the TFT cursor position
@@ -392,29 +1055,55 @@ void TFT_eSPI::drawGlyph(uint16_t code)
     if (cursor_x == 0) cursor_x -= gdX[gNum];
 
     uint8_t* pbuffer = nullptr;
-    const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
 
 #ifdef FONT_FS_AVAILABLE
+    const uint8_t* cbuffer = nullptr;
     if (fs_font)
     {
-      fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is taking >30ms for a significant position shift
-      pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+      cbuffer = getCachedGlyph(gNum);
+      if (!cbuffer)
+      {
+        fontFile.seek(gBitmap[gNum], fs::SeekSet); // This is taking >30ms for a significant position shift
+        pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+      }
     }
 #endif
 
-    int16_t  xs = 0;
-    uint32_t dl = 0;
     uint8_t pixel;
 
     int16_t cy = cursor_y + gFont.maxAscent - gdY[gNum];
     int16_t cx = cursor_x + gdX[gNum];
 
+    // Each run of glyph pixels in a row is blended into a line buffer and sent in one
+    // window. Runs end at zero alpha pixels so anything already drawn there is kept
+    uint16_t lineBuf[gWidth[gNum]];
+
+    // In read back mode transparent text is blended with the screen content. The glyph
+    // box is read in one go before the write transaction starts and written back in
+    // one window
+    uint16_t* rbuffer = nullptr;
+    int32_t bx = cx < 0 ? 0 : cx;
+    int32_t by = cy < 0 ? 0 : cy;
+    int32_t bw = (cx + gWidth[gNum]  > _width  ? _width  : cx + gWidth[gNum])  - bx;
+    int32_t bh = (cy + gHeight[gNum] > _height ? _height : cy + gHeight[gNum]) - by;
+
+    if (fontReadBack && (fg == bg) && (bw > 0) && (bh > 0))
+    {
+      rbuffer = (uint16_t*)malloc(bw * bh * 2);
+      if (rbuffer) readRect(bx, by, bw, bh, rbuffer); // Colours have swapped bytes
+    }
+
     startWrite(); // Avoid slow ESP32 transaction overhead for every pixel
 
+    bool swap = _swapBytes; _swapBytes = true; // Line buffer holds 565 colours
+
     for (int y = 0; y < gHeight[gNum]; y++)
     {
 #ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
+      if (cbuffer) {
+        pbuffer = (uint8_t*)cbuffer + gWidth[gNum] * y; // Point at the line in the cache
+      }
+      else if (fs_font) {
         if (spiffs)
         {
           fontFile.read(pbuffer, gWidth[gNum]);
@@ -429,40 +1118,83 @@ void TFT_eSPI::drawGlyph(uint16_t code)
         }
       }
 #endif
-      for (int x = 0; x < gWidth[gNum]; x++)
+      int32_t py = y + cy;
+      if ((py < 0) || (py >= _height)) continue;
+
+      if (rbuffer)
       {
+        uint16_t* rptr = rbuffer + (py - by) * bw;
+        for (int32_t px = bx; px < bx + bw; px++)
+        {
 #ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
-        else
+          if (fs_font) pixel = pbuffer[px - cx];
+          else
 #endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+          pixel = getGlyphAlpha(gNum, px - cx, y);
 
-        if (pixel)
-        {
-          if (pixel != 0xFF)
+          if (pixel)
           {
-            if (dl) {
-              if (dl==1) drawPixel(xs, y + cy, fg);
-              else drawFastHLine( xs, y + cy, dl, fg);
-              dl = 0;
-            }
-            if (getColor) bg = getColor(x + cx, y + cy);
-            drawPixel(x + cx, y + cy, alphaBlend(pixel, fg, bg));
+            uint16_t color = fg;
+            if (pixel != 0xFF) color = alphaBlend(pixel, fg, (*rptr >> 8) | (*rptr << 8));
+            *rptr = (color >> 8) | (color << 8);
           }
+          rptr++;
+        }
+        continue;
+      }
+
+      int32_t xs = 0; // TFT x coordinate of first pixel in line buffer
+      int32_t np = 0; // Pixels in line buffer
+
+      for (int x = 0; x <= gWidth[gNum]; x++)
+      {
+        int32_t px = x + cx;
+
+        pixel = 0;
+        if (x < gWidth[gNum])
+        {
+#ifdef FONT_FS_AVAILABLE
+          if (fs_font) pixel = pbuffer[x];
+          else
+#endif
+          pixel = getGlyphAlpha(gNum, x, y);
+        }
+
+        // Zero alpha and off screen pixels and the end of the row end the run
+        bool clip = (px < 0) || (px >= _width) || (x == gWidth[gNum]);
+
+        if (pixel && !clip)
+        {
+          if (!np) xs = px;
+          if (pixel == 0xFF) lineBuf[np++] = fg;
           else
           {
-            if (dl==0) xs = x + cx;
-            dl++;
+            if (getColor) bg = getColor(px, py);
+            lineBuf[np++] = alphaBlend(pixel, fg, bg);
           }
         }
-        else
+        else if (np)
         {
-          if (dl) { drawFastHLine( xs, y + cy, dl, fg); dl = 0; }
+          setWindow(xs, py, xs + np - 1, py);
+          pushPixels(lineBuf, np);
+          np = 0;
         }
       }
-      if (dl) { drawFastHLine( xs, y + cy, dl, fg); dl = 0; }
     }
 
+    if (rbuffer)
+    {
+      _swapBytes = false; // Read back colours already have swapped bytes
+      setWindow(bx, by, bx + bw - 1, by + bh - 1);
+      pushPixels(rbuffer, bw * bh);
+      free(rbuffer);
+    }
+
+    _swapBytes = swap; // Restore old value
+
+#ifdef FONT_FS_AVAILABLE
+    if (cbuffer) pbuffer = nullptr; // Cache owns the bitmap
+#endif
     if (pbuffer) free(pbuffer);
     cursor_x += gxAdvance[gNum];
     endWrite();
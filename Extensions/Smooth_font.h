@@ -4,16 +4,59 @@
  public:
 
   // These are for the new antialiased fonts
-  void     loadFont(const uint8_t array[]);
+  void     loadFont(const uint8_t array[]); // vlw array, or font atlas used in place
 #ifdef FONT_FS_AVAILABLE
   void     loadFont(String fontName, fs::FS &ffs);
 #endif
   void     loadFont(String fontName, bool flash = true);
   void     unloadFont( void );
   bool     getUnicodeIndex(uint16_t unicode, uint16_t *index);
+  uint32_t getGlyphIndexSize(void); // RAM in bytes used by the glyph lookup index
+  uint8_t  getGlyphAlpha(uint16_t gNum, int32_t x, int32_t y); // Font array pixel alpha
 
   virtual void drawGlyph(uint16_t code);
 
+  // Cache of glyph bitmaps for fonts loaded from a file, so characters already drawn do
+  // not need a file seek and read. Size is the RAM budget in bytes, 0 disables the cache
+  void     setGlyphCacheSize(uint32_t bytes);
+  void     preloadGlyphs(const char *utf8); // Read the glyphs used in a string into the cache
+
+  // Blend anti-aliased edges of transparent text (no background colour set) with the
+  // colours read back from the TFT or Sprite instead of the text background colour
+  void     setFontReadBack(bool state);
+
+  // Text layout, strings are shaped once into a run of glyphs that is cached and reused
+  // by drawString() and textWidth(). Kerning pairs are loaded from the font file if present
+  void     setKerning(bool state);   // Default is true
+  void     setLigatures(bool state); // Default is false
+  int8_t   getKerning(uint16_t left, uint16_t right);
+
+  typedef struct
+  {
+    uint16_t code;                   // Unicode code of glyph, after ligature substitution
+    int8_t   kern;                   // Kerning adjustment to cursor before the glyph
+  } shapedGlyph_t;
+
+  typedef struct
+  {
+    shapedGlyph_t* glyph;            // Glyph run, string copy follows in same RAM block
+    char*    text;                   // UTF-8 string
+    uint32_t used;                   // gLayoutTick when last used, oldest is replaced first
+    uint16_t size;                   // String length the RAM block can hold, reused if it fits
+    uint16_t count;                  // Number of glyphs in run
+    int16_t  width;                  // Width in pixels, same as textWidth()
+    bool     digits;                 // isDigits was set when width was measured
+    bool     pinned;                 // Kept by cacheTextWidth(), not replaced
+  } textLayout_t;
+
+  const textLayout_t* layoutString(const char *string); // Returns nullptr if no RAM or all runs are kept
+
+  typedef struct
+  {
+    uint32_t key;                    // Left Unicode code << 16 | right Unicode code
+    int8_t   adjust;                 // Pixels to add to cursor advance
+  } kernPair_t;
+
   void     showFont(uint32_t td);
 
  // This is for the whole font
@@ -40,7 +83,29 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   int8_t*   gdX = NULL;       //leftExtent
   uint32_t* gBitmap = NULL;   //file pointer to greyscale bitmap
 
+  // Glyph lookup index, built when the font is loaded
+  uint16_t* gSorted = NULL;   //glyph numbers in Unicode order, only needed if the file is not in order
+  bool      gOrdered = false; //gUnicode codes are in ascending order so can be searched directly
+  uint16_t  gDenseFirst = 0;  //first code of the longest run of consecutive codes (e.g. ASCII)
+  uint16_t  gDenseIndex = 0;  //glyph number of gDenseFirst
+  uint16_t  gDenseCount = 0;  //number of codes in the run
+
+  // Font atlas, the metric arrays above point into the atlas (or gMetrics on ESP8266)
+  bool      fontInPlace = false; //metrics are not allocated individually
+  uint8_t*  gMetrics = nullptr;  //RAM copy of atlas metrics where flash is not byte addressable
+  uint8_t   gAlphaBits = 8;      //bits per glyph pixel alpha value, 8 or 4
+
+  // Kerning pairs and text layout cache
+  kernPair_t*   gKern = nullptr;   //kerning pairs sorted by key
+  uint16_t      gKernCount = 0;    //number of kerning pairs
+  bool          gKernTable = false;//vlw version 12, a kerning table follows the font
+  bool          gKerning = true;   //apply kerning
+  bool          gLigatures = false;//substitute ligatures
+  textLayout_t* gLayout = nullptr; //LAYOUT_CACHE_ENTRIES, allocated when first needed
+  uint32_t      gLayoutTick = 0;   //count of layout look ups
+
   bool     fontLoaded = false; // Flags when a anti-aliased font is loaded
+  bool     fontReadBack = false; // Blend transparent text with the colours already drawn
 
 #ifdef FONT_FS_AVAILABLE
   fs::File fontFile;
@@ -48,6 +113,22 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   bool     spiffs   = true;
   bool     fs_font = false;    // For ESP32/8266 use smooth font file or FLASH (PROGMEM) array
 
+  // Glyph bitmap cache entry
+  typedef struct
+  {
+    uint8_t* bitmap;                 // Alpha values for gWidth x gHeight pixels
+    uint32_t used;                   // gCacheTick when last used, oldest is replaced first
+    uint16_t gNum;                   // Glyph number
+  } glyphCache_t;
+
+  glyphCache_t* gCache = nullptr;    // GLYPH_CACHE_ENTRIES, allocated when first needed
+  uint32_t gCacheSize = GLYPH_CACHE_SIZE; // RAM budget for the bitmaps
+  uint32_t gCacheUsed = 0;           // RAM used by the bitmaps
+  uint32_t gCacheTick = 0;           // Count of cache look ups
+
+  const uint8_t* getCachedGlyph(uint16_t gNum); // Returns nullptr if glyph cannot be cached
+  void     clearGlyphCache(void);
+
 #else
   bool     fontFile = true;
 #endif
@@ -55,6 +136,10 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
   private:
 
   void     loadMetrics(void);
+  void     loadAtlas(const uint8_t array[]);
+  void     loadKerning(uint32_t filePtr);
+  void     clearLayoutCache(void);
+  void     buildGlyphIndex(void);
   uint32_t readInt32(void);
 
   uint8_t* fontPtr = nullptr;
@@ -37,6 +37,20 @@ TFT_eSprite::TFT_eSprite(TFT_eSPI *tft)
   _ypivot = 0;
 
   _colorMap = nullptr;
+  _sharedPalette = false;
+
+  _dirtyCount = 0;
+  _dirtyLast  = 0;
+
+  _shadow = nullptr;
+  _shadowValid = false;
+  _tilesChanged = 0;
+  _tilesTotal = 0;
+
+  _dmaImg = nullptr;
+  _dmaBand = nullptr;
+  _dmaPending = false;
+  _dmaFence = 0;
 
   this->cursor_y = this->cursor_x = 0; // Text cursor position
 
@@ -59,7 +73,7 @@ void* TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t frames)
   _iwidth  = _dwidth  = _bitwidth = w;
   _iheight = _dheight = h;
 
-  _colorMap = nullptr;
+  deletePalette(); // Palette is set after the Sprite is created
 
   this->cursor_x = 0;
   this->cursor_y = 0;
@@ -80,8 +94,9 @@ void* TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t frames)
   _img    = (uint16_t*) _img8;
   _img4   = _img8;
 
+  // Frame 2 follows the guard pixel of frame 1, rounded up to keep it word aligned for DMA
   if ( (_bpp == 16) && (frames > 1) ) {
-    _img8_2 = _img8 + (w * h * 2 + 1);
+    _img8_2 = _img8 + (((w * h + 2) & ~1) << 1);
   }
 
   // ESP32 only 16bpp check
@@ -105,6 +120,11 @@ void* TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t frames)
   if (_img8)
   {
     _created = true;
+
+    // Whole Sprite needs to be sent the first time
+    clearDirty();
+    addDirty(0, 0, _iwidth - 1, _iheight - 1);
+
     return _img8;
   }
 
@@ -120,6 +140,8 @@ TFT_eSprite::~TFT_eSprite(void)
 {
   deleteSprite();
 
+  clearTextWidthCache();
+
 #ifdef SMOOTH_FONT
   if(this->fontLoaded) this->unloadFont();
 #endif
@@ -144,10 +166,10 @@ void* TFT_eSprite::callocSprite(int16_t w, int16_t h, uint8_t frames)
   if (_bpp == 16)
   {
 #if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
-    if ( psramFound() && this->_psram_enable && !_tft->DMA_Enabled) ptr8 = ( uint8_t*) ps_calloc(frames * w * h + frames, sizeof(uint16_t));
+    if ( psramFound() && this->_psram_enable && !_tft->DMA_Enabled) ptr8 = ( uint8_t*) ps_calloc(frames * (w * h + 2), sizeof(uint16_t));
     else
 #endif
-    ptr8 = ( uint8_t*) calloc(frames * w * h + frames, sizeof(uint16_t));
+    ptr8 = ( uint8_t*) calloc(frames * (w * h + 2), sizeof(uint16_t)); // Guard pixel and frame 2 alignment
   }
 
   else if (_bpp == 8)
@@ -170,6 +192,17 @@ void* TFT_eSprite::callocSprite(int16_t w, int16_t h, uint8_t frames)
     ptr8 = ( uint8_t*) calloc(((frames * w * h) >> 1) + frames, sizeof(uint8_t));
   }
 
+  else if (_bpp == 2)
+  {
+    w = (w+3) & 0xFFFC; // width needs to be multiple of 4
+    _iwidth = w;
+#if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
+    if ( psramFound() && this->_psram_enable ) ptr8 = ( uint8_t*) ps_calloc(((frames * w * h) >> 2) + frames, sizeof(uint8_t));
+    else
+#endif
+    ptr8 = ( uint8_t*) calloc(((frames * w * h) >> 2) + frames, sizeof(uint8_t));
+  }
+
   else // Must be 1 bpp
   {
     //_dwidth   Display width+height in pixels always in rotation 0 orientation
@@ -192,15 +225,12 @@ void* TFT_eSprite::callocSprite(int16_t w, int16_t h, uint8_t frames)
 
 /***************************************************************************************
 ** Function name:           createPalette (from RAM array)
-** Description:             Set a palette for a 4-bit per pixel sprite
+** Description:             Set a palette for a 2, 4 or 8 bit per pixel sprite
 *************************************************************************************x*/
 
 void TFT_eSprite::createPalette(uint16_t colorMap[], int colors)
 {
-  if (_colorMap != nullptr)
-  {
-    free(_colorMap);
-  }
+  deletePalette();
 
   if (colorMap == nullptr)
   {
@@ -208,26 +238,27 @@ void TFT_eSprite::createPalette(uint16_t colorMap[], int colors)
   }
 
   // allocate color map
-  _colorMap = (uint16_t *)calloc(16, sizeof(uint16_t));
-  if (colors > 16)
-    colors = 16;
+  uint16_t size = paletteSize();
+  _colorMap = (uint16_t *)calloc(size, sizeof(uint16_t));
+  if (_colorMap == nullptr) return;
+  if (colors > size)
+    colors = size;
   for (auto i = 0; i < colors; i++)
   {
     _colorMap[i] = colorMap[i];
   }
+
+  paletteChanged();
 }
 
 /***************************************************************************************
 ** Function name:           createPalette (from FLASH array)
-** Description:             Set a palette for a 4-bit per pixel sprite
+** Description:             Set a palette for a 2, 4 or 8 bit per pixel sprite
 *************************************************************************************x*/
 
 void TFT_eSprite::createPalette(const uint16_t colorMap[], int colors)
 {
-  if (_colorMap != nullptr)
-  {
-    free(_colorMap);
-  }
+  deletePalette();
 
   if (colorMap == nullptr)
   {
@@ -235,13 +266,66 @@ void TFT_eSprite::createPalette(const uint16_t colorMap[], int colors)
   }
 
   // allocate color map
-  _colorMap = (uint16_t *)calloc(16, sizeof(uint16_t));
-  if (colors > 16)
-    colors = 16;
+  uint16_t size = paletteSize();
+  _colorMap = (uint16_t *)calloc(size, sizeof(uint16_t));
+  if (_colorMap == nullptr) return;
+  if (colors > size)
+    colors = size;
   for (auto i = 0; i < colors; i++)
   {
     _colorMap[i] = pgm_read_word(colorMap++);
   }
+
+  paletteChanged();
+}
+
+/***************************************************************************************
+** Function name:           setPalette
+** Description:             Use a palette held by the sketch, it is not copied
+*************************************************************************************x*/
+void TFT_eSprite::setPalette(uint16_t *palette)
+{
+  deletePalette();
+
+  _colorMap = palette;
+  _sharedPalette = (palette != nullptr);
+
+  paletteChanged();
+}
+
+/***************************************************************************************
+** Function name:           deletePalette
+** Description:             Free the palette if the Sprite owns it
+*************************************************************************************x*/
+void TFT_eSprite::deletePalette(void)
+{
+  if ((_colorMap != nullptr) && !_sharedPalette) free(_colorMap);
+
+  _colorMap = nullptr;
+  _sharedPalette = false;
+}
+
+/***************************************************************************************
+** Function name:           paletteChanged
+** Description:             The whole Sprite must be sent again with the new colours
+*************************************************************************************x*/
+void TFT_eSprite::paletteChanged(void)
+{
+  if (!_created) return;
+
+  addDirty(0, 0, _iwidth - 1, _iheight - 1);
+  shadowStale();
+}
+
+/***************************************************************************************
+** Function name:           paletteSize
+** Description:             Return the number of palette entries for the colour depth
+*************************************************************************************x*/
+uint16_t TFT_eSprite::paletteSize(void)
+{
+  if (_bpp == 8) return 256;
+  if (_bpp == 2) return 4;
+  return 16;
 }
 
 /***************************************************************************************
@@ -260,7 +344,10 @@ void* TFT_eSprite::frameBuffer(int8_t f)
 
   //if (_bpp == 8) _img8 = _img8;
 
-  if (_bpp == 4) _img4 = _img8;
+  if ((_bpp == 4) || (_bpp == 2)) _img4 = _img8;
+
+  // Changes were tracked for the other frame
+  addDirty(0, 0, _iwidth - 1, _iheight - 1);
 
   return _img8;
 }
@@ -273,12 +360,24 @@ void* TFT_eSprite::frameBuffer(int8_t f)
 void* TFT_eSprite::setColorDepth(int8_t b)
 {
   // Can't change an existing sprite's colour depth so delete it
-  if (_created) free(_img8_1);
+  if (_created)
+  {
+    // DMA may still be reading the frame buffer
+    waitUnlock();
+    if (_dmaBand) free(_dmaBand);
+    _dmaBand = nullptr;
+
+    free(_img8_1);
+  }
+
+  // Shadow copy size depends on colour depth
+  deleteShadow();
 
   // Now define the new colour depth
   if ( b > 8 ) _bpp = 16;  // Bytes per pixel
   else if ( b > 4 ) _bpp = 8;
-  else if ( b > 1 ) _bpp = 4;
+  else if ( b > 2 ) _bpp = 4;
+  else if ( b > 1 ) _bpp = 2;
   else _bpp = 1;
 
   // If it existed, re-create the sprite with the new colour depth
@@ -304,6 +403,17 @@ int8_t TFT_eSprite::getColorDepth(void)
 }
 
 
+/***************************************************************************************
+** Function name:           getWireOrder
+** Description:             Check if the frame buffer is in TFT byte order
+*************************************************************************************x*/
+bool TFT_eSprite::getWireOrder(void)
+{
+  // 16 bit colours are stored byte swapped, ready to send
+  return _created && (_bpp == 16);
+}
+
+
 /***************************************************************************************
 ** Function name:           setBitmapColor
 ** Description:             Set the foreground foreground and background colour
@@ -321,8 +431,9 @@ void TFT_eSprite::setBitmapColor(uint16_t c, uint16_t b)
 ***************************************************************************************/
 void TFT_eSprite::setPaletteColor(uint8_t index, uint16_t color)
 {
-  if (_colorMap == nullptr || index > 15)
+  if (_colorMap == nullptr || index >= paletteSize())
     return; // out of bounds
+  paletteChanged();
   _colorMap[index] = color;
 }
 
@@ -332,7 +443,7 @@ void TFT_eSprite::setPaletteColor(uint8_t index, uint16_t color)
 ***************************************************************************************/
 uint16_t TFT_eSprite::getPaletteColor(uint8_t index)
 {
-  if (_colorMap == nullptr || index > 15)
+  if (_colorMap == nullptr || index >= paletteSize())
     return 0;
 
   return _colorMap[index];
@@ -346,14 +457,20 @@ void TFT_eSprite::deleteSprite(void)
 {
   if (!_created ) return;
 
-  if (_colorMap != nullptr)
-  {
-    free(_colorMap);
-  }
+  // DMA may still be reading the frame buffer
+  waitUnlock();
+  if (_dmaBand) free(_dmaBand);
+  _dmaBand = nullptr;
+
+  deletePalette();
 
   free(_img8_1);
 
   _created = false;
+
+  clearDirty();
+
+  deleteShadow();
 }
 
 
@@ -395,7 +512,7 @@ int16_t TFT_eSprite::getPivotY(void)
 #define FP_SCALE 10
 bool TFT_eSprite::pushRotated(int16_t angle, int32_t transp)
 {
-  if ( !_created || _bpp == 4) return false;
+  if ( !_created || _bpp == 4 || _bpp == 2) return false;
 
   // Bounding box parameters
   int16_t min_x;
@@ -406,6 +523,8 @@ bool TFT_eSprite::pushRotated(int16_t angle, int32_t transp)
   // Get the bounding box of this rotated source Sprite relative to Sprite pivot
   if ( !getRotatedBounds(angle, &min_x, &min_y, &max_x, &max_y) ) return false;
 
+  shadowStale();
+
   uint16_t sline_buffer[max_x - min_x + 1];
 
   int32_t xt = min_x - _tft->_xpivot;
@@ -463,8 +582,9 @@ bool TFT_eSprite::pushRotated(int16_t angle, int32_t transp)
 *************************************************************************************x*/
 bool TFT_eSprite::pushRotated(TFT_eSprite *spr, int16_t angle, int32_t transp)
 {
-  if ( !_created  || _bpp == 4) return false;       // Check this Sprite is created
-  if ( !spr->_created  || spr->_bpp == 4) return false;  // Ckeck destination Sprite is created
+  if ( !_created  || _bpp == 4 || _bpp == 2) return false;       // Check this Sprite is created
+  if ( !spr->_created  || spr->_bpp == 4 || spr->_bpp == 2) return false;  // Ckeck destination Sprite is created
+  if ( spr->_colorMap ) return false; // Colours cannot be drawn as palette indexes
 
   // Bounding box parameters
   int16_t min_x;
@@ -649,6 +769,14 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y)
 {
   if (!_created) return;
 
+  // Only send the tiles that have changed if a shadow copy is kept
+  if (_shadow)
+  {
+    pushShadow(x, y);
+    clearDirty();
+    return;
+  }
+
   if (_bpp == 16)
   {
     bool oldSwapBytes = _tft->getSwapBytes();
@@ -663,8 +791,24 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y)
     }
     _tft->pushImage(x, y, _dwidth, _dheight, _img4, false, _colorMap);
   }
+  else if (_bpp == 2)
+  {
+    if (_colorMap == nullptr) return;
+
+    // The palette lookup is done as each line is sent
+    bool oldSwapBytes = _tft->getSwapBytes();
+    _tft->setSwapBytes(false);
+    _tft->startWrite();
+    pushArea(x, y, 0, 0, _dwidth - 1, _dheight - 1);
+    _tft->endWrite();
+    _tft->setSwapBytes(oldSwapBytes);
+  }
+  else if (_bpp == 8) _tft->pushImage(x, y, _dwidth, _dheight, _img8, true, _colorMap);
+
+  else _tft->pushImage(x, y, _dwidth, _dheight, _img8, false);
 
-  else _tft->pushImage(x, y, _dwidth, _dheight, _img8, (bool)(_bpp == 8));
+  // The TFT now holds a copy of the whole Sprite
+  clearDirty();
 }
 
 
@@ -676,6 +820,8 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transp)
 {
   if (!_created) return;
 
+  shadowStale();
+
   if (_bpp == 16)
   {
     bool oldSwapBytes = _tft->getSwapBytes();
@@ -685,17 +831,585 @@ void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transp)
   }
   else if (_bpp == 8)
   {
-    transp = (uint8_t)((transp & 0xE000)>>8 | (transp & 0x0700)>>6 | (transp & 0x0018)>>3);
-    _tft->pushImage(x, y, _dwidth, _dheight, _img8, (uint8_t)transp, (bool)true);
+    // With a palette the transparent colour is a palette index
+    if (_colorMap == nullptr) transp = (uint8_t)((transp & 0xE000)>>8 | (transp & 0x0700)>>6 | (transp & 0x0018)>>3);
+    _tft->pushImage(x, y, _dwidth, _dheight, _img8, (uint8_t)transp, (bool)true, _colorMap);
   }
   else if (_bpp == 4)
   {
     _tft->pushImage(x, y, _dwidth, _dheight, _img4, (uint8_t)(transp & 0x0F), false, _colorMap);
   }
+  else if (_bpp == 2)
+  {
+    if (_colorMap == nullptr) return;
+    transp &= 0x03;
+
+    bool oldSwapBytes = _tft->getSwapBytes();
+    _tft->setSwapBytes(false);
+    _tft->startWrite();
+
+    // Each run of pixels that are not the transparent index is sent in its own window
+    for (int32_t yp = 0; yp < _dheight; yp++)
+    {
+      int32_t xp = 0;
+      while (xp < _dwidth)
+      {
+        while ((xp < _dwidth) && (readPixelValue(xp, yp) == transp)) xp++;
+        int32_t xs = xp;
+        while ((xp < _dwidth) && (readPixelValue(xp, yp) != transp)) xp++;
+        if (xp > xs) pushArea(x, y, xs, yp, xp - 1, yp);
+      }
+    }
+
+    _tft->endWrite();
+    _tft->setSwapBytes(oldSwapBytes);
+  }
   else _tft->pushImage(x, y, _dwidth, _dheight, _img8, 0, (bool)false);
 }
 
 
+/***************************************************************************************
+** Function name:           pushSpriteDirty
+** Description:             Push the changed areas of the sprite to the TFT at x, y
+*************************************************************************************x*/
+uint16_t TFT_eSprite::pushSpriteDirty(int32_t x, int32_t y)
+{
+  if (!_created || !_dirtyCount) return 0;
+
+  if (((_bpp == 4) || (_bpp == 2)) && (_colorMap == nullptr)) return 0;
+
+  // Rotated 1bpp Sprite coordinates do not match the buffer so push it all
+  if ((_bpp == 1) && _rotation) { pushSprite(x, y); return 1; }
+
+  shadowStale();
+
+  uint16_t windows = 0;
+
+  bool oldSwapBytes = _tft->getSwapBytes();
+  _tft->setSwapBytes(false); // pushArea() sets it for the Sprite colour depth
+
+  _tft->startWrite();
+
+  for (uint8_t i = 0; i < _dirtyCount; i++)
+  {
+    if (pushArea(x, y, _dirty[i].xs, _dirty[i].ys, _dirty[i].xe, _dirty[i].ye)) windows++;
+  }
+
+  _tft->endWrite();
+
+  _tft->setSwapBytes(oldSwapBytes);
+
+  clearDirty();
+
+  return windows;
+}
+
+
+/***************************************************************************************
+** Function name:           pushArea
+** Description:             Push an area of the sprite in one TFT window
+*************************************************************************************x*/
+// Sprite is at x, y on the TFT and xs, ys, xe, ye are Sprite coordinates. Must be called
+// between startWrite() and endWrite() with swap bytes off
+bool TFT_eSprite::pushArea(int32_t x, int32_t y, int32_t xs, int32_t ys, int32_t xe, int32_t ye)
+{
+  // Clip to the Sprite image and the TFT screen
+  if (xe >= _dwidth)  xe = _dwidth  - 1;
+  if (ye >= _dheight) ye = _dheight - 1;
+  if (x + xs < 0) xs = -x;
+  if (y + ys < 0) ys = -y;
+  if (x + xe >= _tft->width())  xe = _tft->width()  - x - 1;
+  if (y + ye >= _tft->height()) ye = _tft->height() - y - 1;
+
+  if ((xe < xs) || (ye < ys)) return false;
+
+  int32_t w = xe - xs + 1;
+
+  _tft->setWindow(x + xs, y + ys, x + xe, y + ye);
+
+  if (_bpp == 16)
+  {
+    // Rows of the area are consecutive pixels in the Sprite so can be pushed directly
+    for (int32_t yp = ys; yp <= ye; yp++) _tft->pushPixels(_img + xs + yp * _iwidth, w);
+  }
+  else
+  {
+    // Other colour depths are converted to 565 a chunk of a line at a time. 1 bit pixels
+    // are expanded to the bitmap colours (rotated Sprites are not pushed by area), 8 bit
+    // pixels without a palette are 332 colours converted to bus byte order. Bitmap and
+    // colour map entries are swapped as they are sent
+    bool map = (_bpp != 1) && (_colorMap != nullptr);
+    _tft->setSwapBytes((_bpp == 1) || map);
+
+    uint16_t lineBuf[SPRITE_LINE_CHUNK];
+    for (int32_t yp = ys; yp <= ye; yp++)
+    {
+      for (int32_t xp = xs; xp <= xe; xp += SPRITE_LINE_CHUNK)
+      {
+        uint32_t n = min((int32_t)SPRITE_LINE_CHUNK, xe - xp + 1);
+        if (_bpp == 1)      expandBits(lineBuf, _img8 + ((yp * _bitwidth) >> 3), xp, n, _tft->bitmap_fg, _tft->bitmap_bg, false);
+        else if (!map)      convert8bpp(lineBuf, _img8 + xp + yp * _iwidth, n);
+        else if (_bpp == 8) convert8bpp(lineBuf, _img8 + xp + yp * _iwidth, n, _colorMap);
+        else if (_bpp == 4) convert4bpp(lineBuf, _img4, xp + yp * _iwidth, n, _colorMap);
+        else                convert2bpp(lineBuf, _img4, xp + yp * _iwidth, n, _colorMap);
+        _tft->pushPixels(lineBuf, n);
+      }
+    }
+
+    _tft->setSwapBytes(false);
+  }
+
+  return true;
+}
+
+
+// Processors where pushSpriteDMA() can use DMA
+#if (defined (ESP32_DMA) || defined (STM32_DMA)) && !defined (TFT_PARALLEL_8_BIT)
+  #define SPRITE_DMA
+#endif
+
+/***************************************************************************************
+** Function name:           pushSpriteDMA
+** Description:             Push the sprite to the TFT at x, y using DMA
+*************************************************************************************x*/
+bool TFT_eSprite::pushSpriteDMA(int32_t x, int32_t y)
+{
+  if (!_created) return false;
+
+#ifdef SPRITE_DMA
+  // 1 bit Sprites and Sprites with no palette are pushed without DMA
+  if (!_tft->DMA_Enabled || (_bpp == 1) || ((_bpp < 8) && !_colorMap))
+#endif
+  {
+    pushSprite(x, y);
+    return false;
+  }
+
+#ifdef SPRITE_DMA
+  // Buffers may still be in use by the last push
+  waitUnlock();
+
+  // Clip to the Sprite and the TFT screen, as pushArea()
+  int32_t xs = 0, ys = 0, xe = _dwidth - 1, ye = _dheight - 1;
+  if (x < 0) xs = -x;
+  if (y < 0) ys = -y;
+  if (x + xe >= _tft->width())  xe = _tft->width()  - x - 1;
+  if (y + ye >= _tft->height()) ye = _tft->height() - y - 1;
+
+  if ((xe < xs) || (ye < ys)) return true;
+
+  int32_t w = xe - xs + 1;
+
+  // The TFT will hold a copy of the whole Sprite
+  clearDirty();
+  shadowStale();
+
+  _dmaPending = true;
+
+  if ((_bpp == 16) && (w == _iwidth))
+  {
+    // Whole rows are in TFT byte order, so can be sent straight from the frame buffer
+    _dmaImg = _img8;
+    uint16_t *data = _img + ys * _iwidth;
+  #ifdef ESP32_DMA
+    _dmaFence = _tft->queueImageDMA(x, y + ys, w, ye - ys + 1, data);
+    if (!_dmaFence) { _tft->dmaWait(); _dmaFence = _tft->queueImageDMA(x, y + ys, w, ye - ys + 1, data); }
+  #else
+    _tft->pushImageDMA(x, y + ys, w, ye - ys + 1, data, nullptr, true);
+  #endif
+    return true;
+  }
+
+  // Other Sprites are converted to TFT byte order in bands, DMA sends one band while
+  // the next is converted
+  int32_t rows = SPRITE_DMA_BAND / w;
+  if (!_dmaBand) _dmaBand = (uint16_t*) malloc(2 * SPRITE_DMA_BAND * sizeof(uint16_t));
+  if (!_dmaBand || (rows < 1))
+  {
+    _dmaPending = false;
+    pushSprite(x, y);
+    return false;
+  }
+
+  uint32_t fence[2] = { 0, 0 };
+  uint8_t  band = 0;
+  for (int32_t by = ys; by <= ye; by += rows)
+  {
+    int32_t bh = min(rows, ye - by + 1);
+    uint16_t *buffer = _dmaBand + band * SPRITE_DMA_BAND;
+
+  #ifdef ESP32_DMA
+    // Wait until the band sent from this buffer has gone
+    if (fence[band]) _tft->dmaWaitFence(fence[band]);
+  #endif
+
+    uint16_t *lineBuf = buffer;
+    for (int32_t yp = by; yp < by + bh; yp++)
+    {
+      if (_bpp == 16)         memcpy(lineBuf, _img + xs + yp * _iwidth, w << 1);
+      else if (!_colorMap)    convert8bpp(lineBuf, _img8 + xs + yp * _iwidth, w);
+      else if (_bpp == 8)     convert8bpp(lineBuf, _img8 + xs + yp * _iwidth, w, _colorMap);
+      else if (_bpp == 4)     convert4bpp(lineBuf, _img4, xs + yp * _iwidth, w, _colorMap);
+      else                    convert2bpp(lineBuf, _img4, xs + yp * _iwidth, w, _colorMap);
+
+      // Colour map entries are 565 colours, so swap them to TFT byte order
+      if ((_bpp != 16) && _colorMap) _tft->swapPixels(lineBuf, lineBuf, w);
+      lineBuf += w;
+    }
+
+  #ifdef ESP32_DMA
+    fence[band] = _tft->queueImageDMA(x + xs, y + by, w, bh, buffer);
+    if (!fence[band]) { _tft->dmaWait(); fence[band] = _tft->queueImageDMA(x + xs, y + by, w, bh, buffer); }
+    _dmaFence = fence[band];
+  #else
+    // Waits for the last band to go, so the other buffer is free when this returns
+    _tft->pushImageDMA(x + xs, y + by, w, bh, buffer, nullptr, true);
+  #endif
+
+    band ^= 1;
+  }
+
+  return true;
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           dmaLocked
+** Description:             Check if the last pushSpriteDMA() is still in progress
+*************************************************************************************x*/
+bool TFT_eSprite::dmaLocked(void)
+{
+  if (!_dmaPending) return false;
+
+#ifdef SPRITE_DMA
+  #ifdef ESP32_DMA
+    if ((int32_t)(_tft->dmaFence() - _dmaFence) < 0) return true;
+  #else
+    // Later transfers wait for this one, so it has ended if DMA is idle
+    if (_tft->dmaBusy()) return true;
+  #endif
+#endif
+
+  _dmaPending = false;
+  _dmaImg = nullptr;
+  return false;
+}
+
+
+/***************************************************************************************
+** Function name:           waitUnlock
+** Description:             Wait for the last pushSpriteDMA() to end
+*************************************************************************************x*/
+void TFT_eSprite::waitUnlock(void)
+{
+  if (!_dmaPending) return;
+
+#ifdef SPRITE_DMA
+  #ifdef ESP32_DMA
+    _tft->dmaWaitFence(_dmaFence);
+  #else
+    while (_tft->dmaBusy());
+  #endif
+#endif
+
+  _dmaPending = false;
+  _dmaImg = nullptr;
+}
+
+
+/***************************************************************************************
+** Function name:           createShadow
+** Description:             Allocate a shadow copy of the sprite for tile comparison
+*************************************************************************************x*/
+bool TFT_eSprite::createShadow(void)
+{
+  if (!_created || (_bpp < 8)) return false;
+
+  // Next push sends the whole Sprite
+  _shadowValid = false;
+
+  if (_shadow) return true;
+
+  size_t size = _iwidth * _iheight * (_bpp >> 3);
+
+#if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
+  if ( psramFound() && this->_psram_enable ) _shadow = (uint8_t*) ps_malloc(size);
+  else
+#endif
+  _shadow = (uint8_t*) malloc(size);
+
+  _tilesChanged = 0;
+  _tilesTotal = 0;
+
+  return (_shadow != nullptr);
+}
+
+
+/***************************************************************************************
+** Function name:           deleteShadow
+** Description:             Free the shadow copy, pushSprite() then sends the whole sprite
+*************************************************************************************x*/
+void TFT_eSprite::deleteShadow(void)
+{
+  if (_shadow) free(_shadow);
+
+  _shadow = nullptr;
+  _shadowValid = false;
+}
+
+
+/***************************************************************************************
+** Function name:           shadowStale
+** Description:             Mark the shadow copy as no longer matching the TFT
+*************************************************************************************x*/
+// Pushes that do not go through pushShadow() may change the TFT under the shadow copy,
+// so the next pushSprite() sends the whole Sprite and takes a new copy
+void TFT_eSprite::shadowStale(void)
+{
+  _shadowValid = false;
+}
+
+
+/***************************************************************************************
+** Function name:           getChangedTileRatio
+** Description:             Return the fraction of tiles sent by the last push
+*************************************************************************************x*/
+float TFT_eSprite::getChangedTileRatio(void)
+{
+  if (!_tilesTotal) return 0;
+
+  return (float)_tilesChanged / _tilesTotal;
+}
+
+
+/***************************************************************************************
+** Function name:           pushShadow
+** Description:             Push the tiles that differ from the shadow copy
+*************************************************************************************x*/
+// Compare a line of a tile 32 bits at a time if the pointers and length allow it
+static bool tileLineDiffers(const uint8_t *a, const uint8_t *b, uint32_t len)
+{
+  if ((((uintptr_t)a | (uintptr_t)b | len) & 0x03) == 0)
+  {
+    const uint32_t *wa = (const uint32_t*)a;
+    const uint32_t *wb = (const uint32_t*)b;
+    len >>= 2;
+    while (len--) if (*wa++ != *wb++) return true;
+    return false;
+  }
+
+  return memcmp(a, b, len) != 0;
+}
+
+void TFT_eSprite::pushShadow(int32_t x, int32_t y)
+{
+  uint32_t bpp = _bpp >> 3;        // Bytes per pixel
+  uint32_t bpl = _iwidth * bpp;    // Bytes per line
+
+  int32_t tilesX = (_dwidth  + TFT_SHADOW_TILE - 1) / TFT_SHADOW_TILE;
+  int32_t tilesY = (_dheight + TFT_SHADOW_TILE - 1) / TFT_SHADOW_TILE;
+
+  _tilesTotal = tilesX * tilesY;
+
+  bool oldSwapBytes = _tft->getSwapBytes();
+  _tft->setSwapBytes(false); // pushArea() sets it for the Sprite colour depth
+
+  _tft->startWrite();
+
+  // TFT content is unknown for the first push or a new position, so send it all
+  if (!_shadowValid || (x != _shadowX) || (y != _shadowY))
+  {
+    pushArea(x, y, 0, 0, _dwidth - 1, _dheight - 1);
+    memcpy(_shadow, _img8, bpl * _iheight);
+
+    _tilesChanged = _tilesTotal;
+    _shadowValid = true;
+    _shadowX = x;
+    _shadowY = y;
+  }
+  else
+  {
+    // Flag the tiles that differ from the shadow copy
+    uint8_t changed[_tilesTotal];
+    _tilesChanged = 0;
+
+    for (int32_t ty = 0; ty < tilesY; ty++)
+    {
+      int32_t ys = ty * TFT_SHADOW_TILE;
+      int32_t ye = ys + TFT_SHADOW_TILE;
+      if (ye > _dheight) ye = _dheight;
+
+      for (int32_t tx = 0; tx < tilesX; tx++)
+      {
+        int32_t  xs  = tx * TFT_SHADOW_TILE;
+        uint32_t len = ((xs + TFT_SHADOW_TILE > _dwidth) ? _dwidth - xs : TFT_SHADOW_TILE) * bpp;
+        uint32_t offset = ys * bpl + xs * bpp;
+        uint8_t  diff = 0;
+
+        for (int32_t yp = ys; yp < ye; yp++, offset += bpl)
+        {
+          if (tileLineDiffers(_img8 + offset, _shadow + offset, len)) { diff = 1; break; }
+        }
+
+        changed[tx + ty * tilesX] = diff;
+        _tilesChanged += diff;
+      }
+    }
+
+    // Merge changed tiles into rectangles, a run of tiles in a row is extended down
+    // while the same run of tiles in the next row has changed
+    for (int32_t ty = 0; ty < tilesY; ty++)
+    {
+      for (int32_t tx = 0; tx < tilesX; tx++)
+      {
+        if (!changed[tx + ty * tilesX]) continue;
+
+        int32_t te = tx;
+        while ((te + 1 < tilesX) && changed[te + 1 + ty * tilesX]) te++;
+
+        int32_t tb = ty;
+        while (tb + 1 < tilesY)
+        {
+          int32_t t = tx;
+          while ((t <= te) && changed[t + (tb + 1) * tilesX]) t++;
+          if (t <= te) break;
+          tb++;
+        }
+
+        for (int32_t t = ty; t <= tb; t++) memset(changed + tx + t * tilesX, 0, te - tx + 1);
+
+        int32_t xs = tx * TFT_SHADOW_TILE;
+        int32_t ys = ty * TFT_SHADOW_TILE;
+        int32_t xe = (te + 1) * TFT_SHADOW_TILE - 1;
+        int32_t ye = (tb + 1) * TFT_SHADOW_TILE - 1;
+        if (xe >= _dwidth)  xe = _dwidth  - 1;
+        if (ye >= _dheight) ye = _dheight - 1;
+
+        pushArea(x, y, xs, ys, xe, ye);
+
+        // Update the shadow copy
+        for (int32_t yp = ys; yp <= ye; yp++)
+        {
+          uint32_t offset = yp * bpl + xs * bpp;
+          memcpy(_shadow + offset, _img8 + offset, (xe - xs + 1) * bpp);
+        }
+      }
+    }
+  }
+
+  _tft->endWrite();
+
+  _tft->setSwapBytes(oldSwapBytes);
+}
+
+
+/***************************************************************************************
+** Function name:           markDirty
+** Description:             Add an area to the areas to be sent by pushSpriteDirty()
+*************************************************************************************x*/
+void TFT_eSprite::markDirty(int32_t x, int32_t y, int32_t w, int32_t h)
+{
+  if (!_created) return;
+
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+
+  if ((x + w) > _iwidth)  w = _iwidth  - x;
+  if ((y + h) > _iheight) h = _iheight - y;
+
+  if ((w < 1) || (h < 1)) return;
+
+  addDirty(x, y, x + w - 1, y + h - 1);
+}
+
+
+/***************************************************************************************
+** Function name:           clearDirty
+** Description:             Forget all changed areas
+*************************************************************************************x*/
+void TFT_eSprite::clearDirty(void)
+{
+  _dirtyCount = 0;
+  _dirtyLast  = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           addDirty
+** Description:             Add a clipped rectangle to the changed areas
+*************************************************************************************x*/
+// Number of unchanged pixels sent if the two areas are pushed as one window, this is
+// negative if the areas overlap
+static int32_t dirtyMergeWaste(const tftRect_t *a, const tftRect_t *b)
+{
+  int32_t w = (a->xe > b->xe ? a->xe : b->xe) - (a->xs < b->xs ? a->xs : b->xs) + 1;
+  int32_t h = (a->ye > b->ye ? a->ye : b->ye) - (a->ys < b->ys ? a->ys : b->ys) + 1;
+
+  return w * h - (a->xe - a->xs + 1) * (a->ye - a->ys + 1)
+               - (b->xe - b->xs + 1) * (b->ye - b->ys + 1);
+}
+
+static void dirtyMerge(tftRect_t *a, const tftRect_t *b)
+{
+  if (b->xs < a->xs) a->xs = b->xs;
+  if (b->ys < a->ys) a->ys = b->ys;
+  if (b->xe > a->xe) a->xe = b->xe;
+  if (b->ye > a->ye) a->ye = b->ye;
+}
+
+void TFT_eSprite::addDirty(int32_t xs, int32_t ys, int32_t xe, int32_t ye)
+{
+  // Consecutive writes are often inside the same area (e.g. pixels of a character), so
+  // check that first. Not while a DMA transfer may be reading a frame
+  tftRect_t *r = &_dirty[_dirtyLast];
+  if (_dirtyCount && !_dmaImg && (xs >= r->xs) && (xe <= r->xe) && (ys >= r->ys) && (ye <= r->ye)) return;
+
+  // All writes to the Sprite are tracked here, the frame being sent by DMA must not
+  // change until the transfer ends
+  if (_dmaImg && (_dmaImg == _img8)) waitUnlock();
+
+  if ((xe < xs) || (ye < ys)) return;
+
+  tftRect_t n = { (int16_t)xs, (int16_t)ys, (int16_t)xe, (int16_t)ye };
+
+  // Find the area that grows least if the new one is merged with it
+  uint8_t i = 0;
+  int32_t waste = 0;
+  for (uint8_t j = 0; j < _dirtyCount; j++)
+  {
+    int32_t jw = dirtyMergeWaste(&_dirty[j], &n);
+    if ((j == 0) || (jw < waste)) { i = j; waste = jw; }
+  }
+
+  // Use a new area unless merging is cheaper or all areas are in use
+  if ((_dirtyCount < TFT_DIRTY_RECTS) && ((_dirtyCount == 0) || (waste > TFT_DIRTY_WASTE)))
+  {
+    _dirty[_dirtyCount] = n;
+    _dirtyLast = _dirtyCount++;
+    return;
+  }
+
+  dirtyMerge(&_dirty[i], &n);
+
+  // The enlarged area may now overlap or be close to others, so absorb them
+  uint8_t j = 0;
+  while (j < _dirtyCount)
+  {
+    if ((j != i) && (dirtyMergeWaste(&_dirty[i], &_dirty[j]) <= TFT_DIRTY_WASTE))
+    {
+      dirtyMerge(&_dirty[i], &_dirty[j]);
+      _dirty[j] = _dirty[--_dirtyCount]; // Move the last area into the gap
+      if (i == _dirtyCount) i = j;
+      j = 0;
+    }
+    else j++;
+  }
+
+  _dirtyLast = i;
+}
+
+
 /***************************************************************************************
 ** Function name:           readPixelValue
 ** Description:             Read the color map index of a pixel at defined coordinates
@@ -724,6 +1438,11 @@ uint16_t TFT_eSprite::readPixelValue(int32_t x, int32_t y)
       return _img4[((x+y*_iwidth)>>1)] & 0x0F; // odd index = bits 3 .. 0.
   }
 
+  if (_bpp == 2)
+  {
+    return (_img4[(x+y*_iwidth)>>2] >> ((~x & 0x03) << 1)) & 0x03; // first pixel = bits 7 .. 6
+  }
+
   if (_bpp == 1)
   {
     if (_rotation == 1)
@@ -767,6 +1486,7 @@ uint16_t TFT_eSprite::readPixel(int32_t x, int32_t y)
   if (_bpp == 8)
   {
     uint16_t color = _img8[x + y * _iwidth];
+    if (_colorMap) return _colorMap[color];
     if (color != 0)
     {
     uint8_t  blue[] = {0, 11, 21, 31};
@@ -787,6 +1507,12 @@ uint16_t TFT_eSprite::readPixel(int32_t x, int32_t y)
     return color;
   }
 
+  if (_bpp == 2)
+  {
+    if (_colorMap == nullptr) return 0;
+    return _colorMap[readPixelValue(x, y)];
+  }
+
   if (_rotation == 1)
   {
     uint16_t tx = x;
@@ -836,6 +1562,11 @@ void  TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_
   if (xs + ws >= (int32_t)_iwidth)  ws = _iwidth  - xs;
   if (ys + hs >= (int32_t)_iheight) hs = _iheight - ys;
 
+  // Image colours cannot be converted to palette indexes
+  if ((_bpp == 8) && _colorMap) return;
+
+  if (_bpp >= 8) addDirty(xs, ys, xs + ws - 1, ys + hs - 1); // 1bpp uses drawPixel()
+
   if (_bpp == 16) // Plot a 16 bpp image into a 16 bpp Sprite
   {
     for (int32_t yp = yo; yp < yo + hs; yp++)
@@ -866,7 +1597,7 @@ void  TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_
       ys++;
     }
   }
-  else if (_bpp == 4)
+  else if ((_bpp == 4) || (_bpp == 2))
   {
     // not supported.  The image is unlikely to have the correct colors for the color map.
     // we could implement a way to push a 4-bit image using the color map?
@@ -941,6 +1672,11 @@ void  TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const u
   if (xs + ws >= (int32_t)_iwidth)  ws = _iwidth  - xs;
   if (ys + hs >= (int32_t)_iheight) hs = _iheight - ys;
 
+  // Image colours cannot be converted to palette indexes
+  if ((_bpp == 8) && _colorMap) return;
+
+  if (_bpp >= 8) addDirty(xs, ys, xs + ws - 1, ys + hs - 1); // 1bpp uses drawPixel()
+
   if (_bpp == 16) // Plot a 16 bpp image into a 16 bpp Sprite
   {
     for (int32_t yp = yo; yp < yo + hs; yp++)
@@ -973,7 +1709,7 @@ void  TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const u
     }
   }
 
-  else if (_bpp == 4)
+  else if ((_bpp == 4) || (_bpp == 2))
   {
     #ifdef TFT_eSPI_DEBUG
     Serial.println("TFT_eSprite::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data) not implemented");
@@ -1067,6 +1803,9 @@ void TFT_eSprite::setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
     _ys = y0;
     _xe = x1;
     _ye = y1;
+
+    // Assume the window will be filled by pushColor() or writeColor()
+    addDirty(x0, y0, x1, y1);
   }
 
   _xptr = _xs;
@@ -1087,7 +1826,10 @@ void TFT_eSprite::pushColor(uint32_t color)
     _img [_xptr + _yptr * _iwidth] = (uint16_t) (color >> 8) | (color << 8);
 
   else  if (_bpp == 8)
-    _img8[_xptr + _yptr * _iwidth] = (uint8_t )((color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3);
+  {
+    if (!_colorMap) color = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
+    _img8[_xptr + _yptr * _iwidth] = (uint8_t)color;
+  }
 
   else if (_bpp == 4)
   {
@@ -1129,10 +1871,10 @@ void TFT_eSprite::pushColor(uint32_t color, uint16_t len)
   if (_bpp == 16)
     pixelColor = (uint16_t) (color >> 8) | (color << 8);
 
-  else  if (_bpp == 8)
+  else  if ((_bpp == 8) && !_colorMap)
     pixelColor = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
 
-  else pixelColor = (uint16_t) color; // for 1bpp or 4bpp
+  else pixelColor = (uint16_t) color; // for palette indexes or 1bpp
 
   while(len--) writeColor(pixelColor);
 }
@@ -1213,6 +1955,8 @@ void TFT_eSprite::scroll(int16_t dx, int16_t dy)
     return;
   }
 
+  addDirty(_sx, _sy, _sx + _sw - 1, _sy + _sh - 1);
+
   // Fetch the scroll area width and height set by setScrollRect()
   uint32_t w  = _sw - abs(dx); // line width to copy
   uint32_t h  = _sh - abs(dy); // lines to copy
@@ -1275,7 +2019,7 @@ void TFT_eSprite::scroll(int16_t dx, int16_t dy)
       else  { ty--; fy--; }
     }
   }
-  else if (_bpp == 1 )
+  else if ((_bpp == 1) || (_bpp == 2))
   {
     if (dx >  0) { tx += w; fx += w; } // Start from right edge
     while (h--)
@@ -1289,7 +2033,7 @@ void TFT_eSprite::scroll(int16_t dx, int16_t dy)
       else  { ty--; fy--; }
     }
   }
-  else return; // Not 1, 4, 8 or 16 bpp
+  else return; // Not 1, 2, 4, 8 or 16 bpp
 
   // Fill the gap left by the scrolling
   if (dx > 0) fillRect(_sx, _sy, dx, _sh, _scolor);
@@ -1307,12 +2051,14 @@ void TFT_eSprite::fillSprite(uint32_t color)
 {
   if (!_created ) return;
 
+  addDirty(0, 0, _iwidth - 1, _iheight - 1);
+
   // Use memset if possible as it is super fast
   if(( (uint8_t)color == (uint8_t)(color>>8) ) && _bpp == 16)
                     memset(_img,  (uint8_t)color, _iwidth * _iheight * 2);
   else if (_bpp == 8)
   {
-    color = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
+    if (!_colorMap) color = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
     memset(_img8, (uint8_t)color, _iwidth * _iheight);
   }
   else if (_bpp == 4)
@@ -1320,6 +2066,10 @@ void TFT_eSprite::fillSprite(uint32_t color)
     uint8_t c = ((color & 0x0F) | (((color & 0x0F) << 4) & 0xF0));
     memset(_img4, c, (_iwidth * _iheight) >> 1);
   }
+  else if (_bpp == 2)
+  {
+    memset(_img4, (color & 0x03) * 0x55, (_iwidth * _iheight) >> 2);
+  }
   else if (_bpp == 1)
   {
     if(color) memset(_img8, 0xFF, (_iwidth>>3) * _iheight + 1);
@@ -1413,6 +2163,8 @@ void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint32_t color)
   if ((x < 0) || (y < 0) || !_created) return;
   if ((x >= _iwidth) || (y >= _iheight)) return;
 
+  addDirty(x, y, x, y);
+
   if (_bpp == 16)
   {
     color = (color >> 8) | (color << 8);
@@ -1420,7 +2172,8 @@ void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint32_t color)
   }
   else if (_bpp == 8)
   {
-    _img8[x+y*_iwidth] = (uint8_t)((color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3);
+    if (!_colorMap) color = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
+    _img8[x+y*_iwidth] = (uint8_t)color;
   }
   else if (_bpp == 4)
   {
@@ -1433,6 +2186,12 @@ void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint32_t color)
       _img4[index] =  (uint8_t)(c | (_img4[index] & 0xF0));
     }
   }
+  else if (_bpp == 2)
+  {
+    uint8_t shift = (~x & 0x03) << 1; // first pixel = bits 7 .. 6
+    int index = (x+y*_iwidth)>>2;
+    _img4[index] = (uint8_t)((_img4[index] & ~(0x03 << shift)) | ((color & 0x03) << shift));
+  }
   else // 1 bpp
   {
     if (_rotation == 1)
@@ -1459,6 +2218,38 @@ void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint32_t color)
 }
 
 
+/***************************************************************************************
+** Function name:           drawStringGFX
+** Description:             background and glyphs are drawn separately in Sprite RAM
+***************************************************************************************/
+bool TFT_eSprite::drawStringGFX(const char * /*string*/, int32_t /*x*/, int32_t /*y*/, int32_t /*bx*/, int32_t /*bw*/, int16_t * /*advance*/)
+{
+  return false;
+}
+
+
+/***************************************************************************************
+** Function name:           pushBitmap
+** Description:             bitmap pixels are drawn one at a time in Sprite RAM
+***************************************************************************************/
+bool TFT_eSprite::pushBitmap(int32_t /*x*/, int32_t /*y*/, const uint8_t * /*bitmap*/, int32_t /*w*/, int32_t /*h*/, uint16_t /*fgcolor*/, uint16_t /*bgcolor*/, bool /*lsbFirst*/)
+{
+  return false;
+}
+
+
+/***************************************************************************************
+** Function name:           drawPixels
+** Description:             draw a batch of pixels, no windows to save in a Sprite
+*************************************************************************************x*/
+uint32_t TFT_eSprite::drawPixels(const tftPoint_t *points, const uint16_t *colors, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++) drawPixel(points[i].x, points[i].y, colors[i]);
+
+  return 0;
+}
+
+
 /***************************************************************************************
 ** Function name:           drawLine
 ** Description:             draw a line between 2 arbitrary points
@@ -1530,6 +2321,8 @@ void TFT_eSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
 
   if (h < 1) return;
 
+  addDirty(x, y, x, y + h - 1);
+
   if (_bpp == 16)
   {
     color = (color >> 8) | (color << 8);
@@ -1538,7 +2331,7 @@ void TFT_eSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
   }
   else if (_bpp == 8)
   {
-    color = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
+    if (!_colorMap) color = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
     while (h--) _img8[x + _iwidth * y++] = (uint8_t) color;
   }
   else if (_bpp == 4)
@@ -1585,6 +2378,8 @@ void TFT_eSprite::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
 
   if (w < 1) return;
 
+  addDirty(x, y, x + w - 1, y);
+
   if (_bpp == 16)
   {
     color = (color >> 8) | (color << 8);
@@ -1592,7 +2387,7 @@ void TFT_eSprite::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
   }
   else if (_bpp == 8)
   {
-    color = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
+    if (!_colorMap) color = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
     memset(_img8+_iwidth * y + x, (uint8_t)color, w);
   }
   else if (_bpp == 4)
@@ -1644,6 +2439,8 @@ void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t
 
   if ((w < 1) || (h < 1)) return;
 
+  addDirty(x, y, x + w - 1, y + h - 1);
+
   int32_t yp = _iwidth * y + x;
 
   if (_bpp == 16)
@@ -1661,7 +2458,7 @@ void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t
   }
   else if (_bpp == 8)
   {
-    color = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
+    if (!_colorMap) color = (color & 0xE000)>>8 | (color & 0x0700)>>6 | (color & 0x0018)>>3;
     while (h--)
     {
       memset(_img8 + yp, (uint8_t)color, w);
@@ -1670,53 +2467,8 @@ void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t
   }
   else if (_bpp == 4)
   {
-    uint8_t c1 = (uint8_t)color & 0x0F;
-    uint8_t c2 = c1 | ((c1 << 4) & 0xF0);
-    if ((x & 0x01) == 0 && (w & 0x01) == 0)
-    {
-      yp = (yp >> 1);
-      while (h--)
-      {
-        memset(_img4 + yp, c2, (w>>1));
-        yp += (_iwidth >> 1);
-      }
-    }
-    else if ((x & 0x01) == 0)
-    {
-      // same as above but you have a hangover on the right.
-      yp = (yp >> 1);
-      while (h--)
-      {
-        if (w > 1)
-          memset(_img4 + yp, c2, (w-1)>>1);
-        // handle the rightmost pixel by calling drawPixel
-        drawPixel(x+w-1, y+h, c1);
-        yp += (_iwidth >> 1);
-      }
-    }
-    else if ((w & 0x01) == 1)
-    {
-      yp = (yp + 1) >> 1;
-      while (h--) {
-        drawPixel(x, y+h-1, color & 0x0F);
-        if (w > 1)
-          memset(_img4 + (yp + ((x-1)>>1)), c2, (w-1)>>1);
-        // same as above but you have a hangover on the left instead
-        yp += (_iwidth >> 1);
-      }
-    }
-    else
-    {
-      yp = (yp + 1) >> 1;
-      while (h--) {
-        drawPixel(x, y+h-1, color & 0x0F);
-        drawPixel(x+w-1, y+h-1, color & 0x0F);
-        if (w > 2)
-          memset(_img4 + (yp + ((x-1)>>1)), c2, (w-2)>>1);
-        // maximal hacking, single pixels on left and right.
-        yp += (_iwidth >> 1);
-      }
-    }
+    // Lines handle the pixels at odd x that share a byte with a pixel outside the rectangle
+    while (h--) drawFastHLine(x, y++, w, color);
   }
   else
   {
@@ -2069,7 +2821,7 @@ int16_t TFT_eSprite::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t fo
 
   int32_t width  = 0;
   int32_t height = 0;
-  uint32_t flash_address = 0;
+  uintptr_t flash_address = 0; // Pointer sized so fonts can be used on 64 bit hosts
   uniCode -= 32;
 
 #ifdef LOAD_FONT2
@@ -2155,50 +2907,29 @@ int16_t TFT_eSprite::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t fo
     w *= height; // Now w is total number of pixels in the character
 
     if (textcolor != textbgcolor) fillRect(x, pY, width * textsize, textsize * height, textbgcolor);
-    int16_t color = textcolor;
-    if (_bpp == 16) color = (textcolor >> 8) | (textcolor << 8);
-    else if (_bpp == 8) color = ((textcolor & 0xE000)>>8 | (textcolor & 0x0700)>>6 | (textcolor & 0x0018)>>3);
-    int32_t px = 0, py = pY; // To hold character block start and end column and row values
     int32_t pc = 0; // Pixel count
-    uint8_t np = textsize * textsize; // Number of pixels in a drawn pixel
-    uint8_t tnp = 0; // Temporary copy of np for while loop
-    uint8_t ts = textsize - 1; // Temporary copy of textsize
     // 16 bit pixel count so maximum font size is equivalent to 180x180 pixels in area
     // w is total number of pixels to plot to fill character block
     while (pc < w)
     {
       line = pgm_read_byte((uint8_t *)flash_address);
       flash_address++; // 20 bytes smaller by incrementing here
+      uint8_t run = (line & 0x7F) + 1;
       if (line & 0x80) {
-        line &= 0x7F;
-        line++;
-        if (ts) {
-          px = x + textsize * (pc % width); // Keep these px and py calculations outside the loop as they are slow
-          py = y + textsize * (pc / width);
-        }
-        else {
-          px = x + pc % width; // Keep these px and py calculations outside the loop as they are slow
-          py = y + pc / width;
+        // Foreground run, drawn as one scaled rectangle for each glyph line it covers
+        int32_t px = pc % width; // Keep these px and py calculations outside the loop as they are slow
+        int32_t py = pc / width;
+        while (run) {
+          int32_t np = width - px;
+          if (np > run) np = run;
+          fillRect(x + px * textsize, y + py * textsize, np * textsize, textsize, textcolor);
+          run -= np;
+          pc  += np;
+          px = 0;
+          py++;
         }
-        while (line--) {
-          pc++;
-          setWindow(px, py, px + ts, py + ts);
-          if (ts) { tnp = np; while (tnp--) writeColor(color); }
-          else    writeColor(color);
-
-          px += textsize;
-
-          if (px >= (x + width * textsize))
-          {
-            px = x;
-            py += textsize;
-          }
-        }
-      }
-      else {
-        line++;
-        pc += line;
       }
+      else pc += run;
     }
   }
   // End of RLE font rendering
@@ -2271,12 +3002,15 @@ void TFT_eSprite::drawGlyph(uint16_t code)
     }
 
     uint8_t* pbuffer = nullptr;
-    const uint8_t* gPtr = (const uint8_t*) this->gFont.gArray;
 
 #ifdef FONT_FS_AVAILABLE
+    const uint8_t* cbuffer = nullptr;
     if (this->fs_font) {
-      this->fontFile.seek(this->gBitmap[gNum], fs::SeekSet); // This is slow for a significant position shift!
-      pbuffer =  (uint8_t*)malloc(this->gWidth[gNum]);
+      cbuffer = this->getCachedGlyph(gNum);
+      if (!cbuffer) {
+        this->fontFile.seek(this->gBitmap[gNum], fs::SeekSet); // This is slow for a significant position shift!
+        pbuffer =  (uint8_t*)malloc(this->gWidth[gNum]);
+      }
     }
 #endif
 
@@ -2284,10 +3018,16 @@ void TFT_eSprite::drawGlyph(uint16_t code)
     uint16_t dl = 0;
     uint8_t pixel = 0;
 
+    // Blend transparent text with the Sprite content, Sprites with a palette hold indexes
+    bool readBack = this->fontReadBack && (fg == bg) && !newSprite && (_bpp >= 8) && !_colorMap;
+
     for (int32_t y = 0; y < this->gHeight[gNum]; y++)
     {
 #ifdef FONT_FS_AVAILABLE
-      if (this->fs_font) {
+      if (cbuffer) {
+        pbuffer = (uint8_t*)cbuffer + this->gWidth[gNum] * y; // Point at the line in the cache
+      }
+      else if (this->fs_font) {
         this->fontFile.read(pbuffer, this->gWidth[gNum]);
       }
 #endif
@@ -2299,13 +3039,14 @@ void TFT_eSprite::drawGlyph(uint16_t code)
         }
         else
 #endif
-        pixel = pgm_read_byte(gPtr + this->gBitmap[gNum] + x + this->gWidth[gNum] * y);
+        pixel = this->getGlyphAlpha(gNum, x, y);
 
         if (pixel)
         {
           if (pixel != 0xFF)
           {
             if (dl) { drawFastHLine( xs, y + this->cursor_y + this->gFont.maxAscent - this->gdY[gNum], dl, fg); dl = 0; }
+            if (readBack) bg = readPixel(x + this->cursor_x + this->gdX[gNum], y + this->cursor_y + this->gFont.maxAscent - this->gdY[gNum]);
             if (_bpp != 1) drawPixel(x + this->cursor_x + this->gdX[gNum], y + this->cursor_y + this->gFont.maxAscent - this->gdY[gNum], alphaBlend(pixel, fg, bg));
             else if (pixel>127) drawPixel(x + this->cursor_x + this->gdX[gNum], y + this->cursor_y + this->gFont.maxAscent - this->gdY[gNum], fg);
           }
@@ -2323,6 +3064,9 @@ void TFT_eSprite::drawGlyph(uint16_t code)
       if (dl) { drawFastHLine( xs, y + this->cursor_y + this->gFont.maxAscent - this->gdY[gNum], dl, fg); dl = 0; }
     }
 
+#ifdef FONT_FS_AVAILABLE
+    if (cbuffer) pbuffer = nullptr; // Cache owns the bitmap
+#endif
     if (pbuffer) free(pbuffer);
 
     if (newSprite)
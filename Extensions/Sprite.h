@@ -5,6 +5,35 @@
 // graphics are written to the Sprite rather than the TFT.
 ***************************************************************************************/
 
+// Maximum number of changed areas tracked for pushSpriteDirty(), when all are in use a
+// new area is merged with the nearest one
+#ifndef TFT_DIRTY_RECTS
+  #define TFT_DIRTY_RECTS 8
+#endif
+
+// Two changed areas are merged into one window if that sends no more than this number
+// of unchanged pixels, it is cheaper than the address commands for another window
+#ifndef TFT_DIRTY_WASTE
+  #define TFT_DIRTY_WASTE 64
+#endif
+
+// Size in pixels of the square tiles compared when a Sprite has a shadow copy
+#ifndef TFT_SHADOW_TILE
+  #define TFT_SHADOW_TILE 16
+#endif
+
+// Size in pixels of each of the two band buffers pushSpriteDMA() uses to convert Sprites
+// that cannot be sent directly from the frame buffer
+#ifndef SPRITE_DMA_BAND
+  #define SPRITE_DMA_BAND 1024
+#endif
+
+// Pixels converted at a time when a Sprite area that is not 16 bit is sent to the TFT,
+// the buffer is on the stack
+#ifndef SPRITE_LINE_CHUNK
+  #define SPRITE_LINE_CHUNK 64
+#endif
+
 class TFT_eSprite : public TFT_eSPI {
 
  public:
@@ -15,6 +44,7 @@ class TFT_eSprite : public TFT_eSPI {
            // Sketch can cast returned value to (uint16_t*) for 16 bit depth if needed
            // RAM required is:
            //  - 1 bit per pixel for 1 bit colour depth
+           //  - 2 or 4 bits per pixel for 2 or 4 bit colour depth (palette indexes)
            //  - 1 byte per pixel for 8 bit colour
            //  - 2 bytes per pixel for 16 bit color depth
   ~TFT_eSprite(void);
@@ -28,15 +58,29 @@ class TFT_eSprite : public TFT_eSPI {
            // Returns a pointer to the Sprite frame buffer
   void*    frameBuffer(int8_t f);
   
-           // Set or get the colour depth to 4, 8 or 16 bits. Can be used to change depth an existing
+           // Set or get the colour depth to 1, 2, 4, 8 or 16 bits. Can be used to change depth an existing
            // sprite, but clears it to black, returns a new pointer if sprite is re-created.
   void*    setColorDepth(int8_t b);
   int8_t   getColorDepth(void);
 
-           // Set the palette for a 4 bit depth sprite.  Only the first 16 colours in the map are used.
+           // Returns true if the frame buffer holds 16 bit colours in TFT byte order (16 bit Sprites),
+           // so it can be sent by pushImageDMA() and pushPixelsDMA() without byte swapping
+  bool     getWireOrder(void);
+
+           // Set the palette for a 2, 4 or 8 bit depth sprite, the colours are copied. 2 and 4 bit
+           // Sprites use 4 and 16 colours. An 8 bit Sprite with a palette holds indexes to 256
+           // colours instead of 332 colours, and is drawn with palette indexes as colours.
+           // The palette is set after the Sprite is created, nullptr removes it.
   void     createPalette(uint16_t *palette, int colors = 16);       // Palette in RAM
   void     createPalette(const uint16_t *palette, int colors = 16); // Palette in FLASH
 
+           // Use a palette in RAM without copying it, so one palette can be shared by many Sprites.
+           // It must hold a colour for every index (4, 16 or 256) and stay in scope while in use.
+           // After the shared colours are changed call paletteChanged() for each Sprite using them,
+           // so the next pushSprite() or pushSpriteDirty() sends the whole Sprite
+  void     setPalette(uint16_t *palette);
+  void     paletteChanged(void);
+
            // Set a single palette index to the given color
   void     setPaletteColor(uint8_t index, uint16_t color);
 
@@ -48,6 +92,8 @@ class TFT_eSprite : public TFT_eSPI {
 
   void     drawPixel(int32_t x, int32_t y, uint32_t color);
 
+  uint32_t drawPixels(const tftPoint_t *points, const uint16_t *colors, uint32_t n);
+
   void     drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t font),
 
            // Fill Sprite with a colour
@@ -111,10 +157,10 @@ class TFT_eSprite : public TFT_eSPI {
   uint16_t readPixel(int32_t x0, int32_t y0);
 
            // return the numerical value of the pixel at x,y (used when scrolling)
-           // 16bpp = colour, 8bpp = byte, 4bpp = colour index, 1bpp = 1 or 0
+           // 16bpp = colour, 8bpp = byte, 4bpp and 2bpp = colour index, 1bpp = 1 or 0
   uint16_t readPixelValue(int32_t x, int32_t y);
 
-           // Write an image (colour bitmap) to the sprite.  Not implemented for _bpp == 4.
+           // Write an image (colour bitmap) to the sprite. Not implemented for Sprites with a palette.
   void     pushImage(int32_t x0, int32_t y0, int32_t w, int32_t h, uint16_t *data);
   void     pushImage(int32_t x0, int32_t y0, int32_t w, int32_t h, const uint16_t *data);
 
@@ -127,6 +173,35 @@ class TFT_eSprite : public TFT_eSPI {
   void     pushSprite(int32_t x, int32_t y);
   void     pushSprite(int32_t x, int32_t y, uint16_t transparent);
 
+           // Push only the areas of the Sprite changed since the last pushSprite(x, y) or
+           // pushSpriteDirty(), returns the number of TFT windows used
+  uint16_t pushSpriteDirty(int32_t x, int32_t y);
+
+           // Push the sprite to the TFT with DMA (ESP32 and STM32) without waiting for the transfer
+           // to end. Use tft.startWrite() first, as for pushImageDMA(). A 16 bit Sprite that fits the
+           // screen width is sent straight from the frame buffer, which stays locked until the transfer
+           // ends: drawing in that frame, pushing it again or deleting the Sprite waits. Other Sprites
+           // (not 1 bit) are converted in bands, returning when the last band has been started.
+           // Without DMA the Sprite is sent by pushSprite() and false is returned
+  bool     pushSpriteDMA(int32_t x, int32_t y);
+
+           // Check if the last pushSpriteDMA() is still in progress, or wait for it to end
+  bool     dmaLocked(void);
+  void     waitUnlock(void);
+
+           // Add an area to the changed areas, needed if the sketch writes directly to the
+           // Sprite buffer. clearDirty() forgets all changes
+  void     markDirty(int32_t x, int32_t y, int32_t w, int32_t h);
+  void     clearDirty(void);
+
+           // Keep a shadow copy of the frame sent by pushSprite(x, y) so the next push only
+           // sends the tiles that differ. 8 and 16 bpp only, returns false if there is no RAM
+  bool     createShadow(void);
+  void     deleteShadow(void);
+
+           // Fraction (0.0 to 1.0) of the tiles sent by the last pushSprite(x, y) with a shadow
+  float    getChangedTileRatio(void);
+
   int16_t  drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font),
            drawChar(uint16_t uniCode, int32_t x, int32_t y);
 
@@ -150,16 +225,39 @@ class TFT_eSprite : public TFT_eSPI {
            // Reserve memory for the Sprite and return a pointer
   void*    callocSprite(int16_t width, int16_t height, uint8_t frames = 1);
 
+           // Add a rectangle to the changed areas, merging it with others where possible
+  void     addDirty(int32_t xs, int32_t ys, int32_t xe, int32_t ye);
+
+           // Free the palette unless it is shared and return the number of palette entries
+  void     deletePalette(void);
+  uint16_t paletteSize(void);
+
+           // Push an area of the Sprite to the TFT, returns false if it is off screen
+  bool     pushArea(int32_t x, int32_t y, int32_t xs, int32_t ys, int32_t xe, int32_t ye);
+
+           // Push the tiles that differ from the shadow copy and update it
+  void     pushShadow(int32_t x, int32_t y);
+
+           // Mark the shadow copy as no longer matching the TFT
+  void     shadowStale(void);
+
  protected:
 
-  uint8_t  _bpp;     // bits per pixel (1, 8 or 16)
+           // Free font strings are drawn character by character in a Sprite
+  bool     drawStringGFX(const char *string, int32_t x, int32_t y, int32_t bx, int32_t bw, int16_t *advance);
+
+           // Bitmaps with a background are drawn pixel by pixel in a Sprite
+  bool     pushBitmap(int32_t x, int32_t y, const uint8_t *bitmap, int32_t w, int32_t h, uint16_t fgcolor, uint16_t bgcolor, bool lsbFirst);
+
+  uint8_t  _bpp;     // bits per pixel (1, 2, 4, 8 or 16)
   uint16_t *_img;    // pointer to 16 bit sprite
   uint8_t  *_img8;   // pointer to  8 bit sprite
-  uint8_t  *_img4;   // pointer to 4 bit sprite (uses color map)
+  uint8_t  *_img4;   // pointer to 4 or 2 bit sprite (uses color map)
   uint8_t  *_img8_1; // pointer to  frame 1
   uint8_t  *_img8_2; // pointer to  frame 2
 
-  uint16_t *_colorMap; // color map: 16 entries, used with 4 bit color map.
+  uint16_t *_colorMap; // color map: 4, 16 or 256 entries, used with 2, 4 or 8 bit color map.
+  bool     _sharedPalette; // _colorMap belongs to the sketch (setPalette)
 
   int16_t  _xpivot;   // x pivot point coordinate
   int16_t  _ypivot;   // y pivot point coordinate
@@ -182,4 +280,19 @@ class TFT_eSprite : public TFT_eSPI {
   int32_t  _dwidth, _dheight; // Real display width and height (for <8bpp Sprites)
   int32_t  _bitwidth;         // Sprite image bit width for drawPixel (for <8bpp Sprites, not swapped)
 
+  tftRect_t _dirty[TFT_DIRTY_RECTS]; // Areas changed since the last push
+  uint8_t  _dirtyCount;              // Number of changed areas in use
+  uint8_t  _dirtyLast;               // Last area changed, checked first
+
+  uint8_t  *_shadow;          // Copy of the last frame pushed, for tile comparison
+  bool     _shadowValid;      // Shadow copy is on the TFT at _shadowX, _shadowY
+  int32_t  _shadowX, _shadowY;
+  uint16_t _tilesChanged;     // Tiles sent by the last push
+  uint16_t _tilesTotal;       // Tiles in the Sprite
+
+  uint8_t  *_dmaImg;          // Frame being sent by pushSpriteDMA(), writes to it must wait
+  uint16_t *_dmaBand;         // Two band buffers for pushSpriteDMA()
+  bool     _dmaPending;       // A pushSpriteDMA() transfer may still be in progress
+  uint32_t _dmaFence;         // ESP32 fence value of its last block
+
 };
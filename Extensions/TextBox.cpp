@@ -0,0 +1,480 @@
+/***************************************************************************************
+** Code for the text box UI element
+***************************************************************************************/
+
+/***************************************************************************************
+** Function name:           TFT_eSPI_TextBox
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eSPI_TextBox::TFT_eSPI_TextBox(void)
+{
+  _gfx       = nullptr;
+  _spr       = nullptr;
+
+  _x = _y = _w = _h = 0;
+  _fgcolor   = TFT_WHITE;
+  _bgcolor   = TFT_BLACK;
+  _datum     = TL_DATUM;
+  _spacing   = 0;
+  _bottom    = false;
+
+  _text      = nullptr;
+  _textLen   = 0;
+  _textMax   = 0;
+
+  _line      = nullptr;
+  _lineCount = 0;
+  _lineMax   = 0;
+  _lineFont  = 0;
+
+  _measure.start = _measure.end = 0xFFFF;
+
+  _rowHash   = nullptr;
+  _rows      = 0;
+  _redraw    = true;
+}
+
+/***************************************************************************************
+** Function name:           ~TFT_eSPI_TextBox
+** Description:             Class destructor
+***************************************************************************************/
+TFT_eSPI_TextBox::~TFT_eSPI_TextBox(void)
+{
+  if (_text)    free(_text);
+  if (_line)    free(_line);
+  if (_rowHash) free(_rowHash);
+}
+
+/***************************************************************************************
+** Function name:           initTextBox
+** Description:             Set the TFT and box area
+***************************************************************************************/
+void TFT_eSPI_TextBox::initTextBox(TFT_eSPI *gfx, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+  _gfx = gfx;
+  _spr = nullptr;
+  _x = x; _y = y; _w = w; _h = h;
+
+  _lineFont = 0; // Break lines again for the new width
+  _redraw = true;
+}
+
+/***************************************************************************************
+** Function name:           initTextBox
+** Description:             Set the Sprite and box area, rows are scrolled in the Sprite
+***************************************************************************************/
+void TFT_eSPI_TextBox::initTextBox(TFT_eSprite *spr, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+  initTextBox((TFT_eSPI*)spr, x, y, w, h);
+  _spr = spr;
+}
+
+/***************************************************************************************
+** Function name:           setTextColor
+** Description:             Set the text and background colours
+***************************************************************************************/
+void TFT_eSPI_TextBox::setTextColor(uint16_t fgcolor, uint16_t bgcolor)
+{
+  if ((fgcolor == _fgcolor) && (bgcolor == _bgcolor)) return;
+  _fgcolor = fgcolor;
+  _bgcolor = bgcolor;
+  _redraw = true;
+}
+
+/***************************************************************************************
+** Function name:           setAlignment
+** Description:             Set horizontal alignment, only the left/centre/right part is used
+***************************************************************************************/
+void TFT_eSPI_TextBox::setAlignment(uint8_t datum)
+{
+  datum = datum % 3; // TL_DATUM, TC_DATUM or TR_DATUM
+  if (datum == _datum) return;
+  _datum = datum;
+  _redraw = true;
+}
+
+/***************************************************************************************
+** Function name:           setLineSpacing
+** Description:             Set extra pixels between lines
+***************************************************************************************/
+void TFT_eSPI_TextBox::setLineSpacing(int16_t spacing)
+{
+  if (spacing == _spacing) return;
+  _spacing = spacing;
+  _redraw = true;
+}
+
+/***************************************************************************************
+** Function name:           setScroll
+** Description:             Show the first (false) or last (true) lines of the text
+***************************************************************************************/
+void TFT_eSPI_TextBox::setScroll(bool bottom)
+{
+  if (bottom == _bottom) return;
+  _bottom = bottom;
+}
+
+/***************************************************************************************
+** Function name:           setText
+** Description:             Replace the text, lines are re-calculated from the first change
+***************************************************************************************/
+bool TFT_eSPI_TextBox::setText(const char *text)
+{
+  if (!text) text = "";
+
+  uint32_t len = strlen(text);
+  if (len > 0xFFFF - 1) return false;
+  if (!reserve(len)) return false;
+
+  // Find the first byte that differs, lines before it are kept
+  uint16_t changed = 0;
+  while ((changed < _textLen) && (changed < len) && (_text[changed] == text[changed])) changed++;
+  if ((changed == _textLen) && (changed == len)) return true;
+
+  memcpy(_text + changed, text + changed, len - changed);
+  _textLen = len;
+  _text[_textLen] = 0;
+
+  update(changed);
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           appendText
+** Description:             Add to the end of the text, e.g. for a log view
+***************************************************************************************/
+bool TFT_eSPI_TextBox::appendText(const char *text)
+{
+  if (!text || !*text) return true;
+
+  uint32_t len = strlen(text);
+  if ((uint32_t)_textLen + len > 0xFFFF - 1) return false;
+  if (!reserve(_textLen + len)) return false;
+
+  uint16_t changed = _textLen;
+  memcpy(_text + _textLen, text, len);
+  _textLen += len;
+  _text[_textLen] = 0;
+
+  update(changed);
+
+  // Discard lines that have scrolled out of the top of the box
+  uint16_t rows = getRowCount();
+  if (_bottom && (_lineCount > rows))
+  {
+    uint16_t drop  = _lineCount - rows;
+    uint16_t start = (rows > 0) ? _line[drop].start : _textLen;
+
+    memmove(_text, _text + start, _textLen - start + 1);
+    _textLen -= start;
+
+    for (uint16_t i = 0; i < rows; i++)
+    {
+      _line[i] = _line[i + drop];
+      _line[i].start -= start;
+    }
+    _lineCount = rows;
+  }
+
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           clear
+** Description:             Remove all the text, the box is cleared by the next draw()
+***************************************************************************************/
+void TFT_eSPI_TextBox::clear(void)
+{
+  _textLen = 0;
+  if (_text) _text[0] = 0;
+  _lineCount = 0;
+}
+
+/***************************************************************************************
+** Function name:           getLineCount
+** Description:             Return the number of lines the text is broken into
+***************************************************************************************/
+uint16_t TFT_eSPI_TextBox::getLineCount(void)
+{
+  if (_gfx && (fontId() != _lineFont)) layout(0);
+  return _lineCount;
+}
+
+/***************************************************************************************
+** Function name:           getRowCount
+** Description:             Return the number of lines that fit in the box
+***************************************************************************************/
+uint16_t TFT_eSPI_TextBox::getRowCount(void)
+{
+  if (!_gfx) return 0;
+
+  int16_t fh = _gfx->fontHeight();
+  int16_t lineH = fh + _spacing;
+  if (lineH < 1) lineH = 1;
+
+  if ((fh <= 0) || (_h < fh)) return 0;
+  return (_h - fh) / lineH + 1;
+}
+
+/***************************************************************************************
+** Function name:           draw
+** Description:             Draw the rows that have changed, or all rows
+***************************************************************************************/
+void TFT_eSPI_TextBox::draw(bool all)
+{
+  if (!_gfx) return;
+
+  // Break the lines again if a different font has been selected
+  if (fontId() != _lineFont)
+  {
+    layout(0);
+    _redraw = true;
+  }
+
+  uint16_t rows = getRowCount();
+  int16_t lineH = _gfx->fontHeight() + _spacing;
+  if (lineH < 1) lineH = 1;
+
+  if (rows != _rows)
+  {
+    if (_rowHash) free(_rowHash);
+    _rowHash = rows ? (uint32_t*)calloc(rows, sizeof(uint32_t)) : nullptr;
+    _rows = _rowHash ? rows : 0;
+    _redraw = true;
+  }
+
+  if (all || _redraw)
+  {
+    _gfx->fillRect(_x, _y, _w, _h, _bgcolor);
+    for (uint16_t r = 0; r < _rows; r++) _rowHash[r] = 0; // 0 = blank row
+    _redraw = false;
+  }
+
+  if (!_rows) return;
+
+  // First line shown
+  uint16_t top = 0;
+  if (_bottom && (_lineCount > _rows)) top = _lineCount - _rows;
+
+  // In a Sprite, move the rows up if the lines have moved up (e.g. a log view) so
+  // only the new rows are drawn
+  if (_spr && (lineHash(top) != _rowHash[0]))
+  {
+    for (uint16_t k = 1; k < _rows; k++)
+    {
+      uint16_t r = 0;
+      for (; r < _rows - k; r++)
+      {
+        if (_rowHash[r + k] == 0) break; // Only shift rows that hold text
+        if (lineHash(top + r) != _rowHash[r + k]) break;
+      }
+      if (r < _rows - k) continue;
+
+      // Rows k onwards now show lines 0 onwards
+      _spr->setScrollRect(_x, _y, _w, min((int32_t)(_rows * lineH), _h), _bgcolor);
+      _spr->scroll(0, -k * lineH);
+      for (r = 0; r < _rows; r++) _rowHash[r] = (r + k < _rows) ? _rowHash[r + k] : 0;
+      break;
+    }
+  }
+
+  uint8_t  tempdatum   = _gfx->getTextDatum();
+  uint16_t tempPadding = _gfx->padX;
+  uint32_t tempColor   = _gfx->textcolor;
+  uint32_t tempBgColor = _gfx->textbgcolor;
+  _gfx->setTextDatum(_datum);
+  _gfx->setTextPadding(0);
+  _gfx->setTextColor(_fgcolor, _bgcolor);
+
+  int32_t xd = _x;
+  if (_datum == TC_DATUM) xd += _w / 2;
+  else if (_datum == TR_DATUM) xd += _w;
+
+  char buf[TEXTBOX_LINE_MAX + 1];
+
+  for (uint16_t r = 0; r < _rows; r++)
+  {
+    uint16_t n = top + r;
+    uint32_t hash = lineHash(n);
+    if (hash == _rowHash[r]) continue;
+    _rowHash[r] = hash;
+
+    int32_t y = _y + r * lineH;
+    _gfx->fillRect(_x, y, _w, (r < _rows - 1) ? lineH : _h - r * lineH, _bgcolor);
+
+    if (n >= _lineCount || !_line[n].len) continue;
+    memcpy(buf, _text + _line[n].start, _line[n].len);
+    buf[_line[n].len] = 0;
+    _gfx->drawString(buf, xd, y);
+  }
+
+  _gfx->setTextDatum(tempdatum);
+  _gfx->setTextPadding(tempPadding);
+  _gfx->setTextColor(tempColor, tempBgColor);
+}
+
+/***************************************************************************************
+** Function name:           reserve
+** Description:             Make sure the text buffer can hold len bytes plus terminator
+***************************************************************************************/
+bool TFT_eSPI_TextBox::reserve(uint16_t len)
+{
+  if (_text && (len <= _textMax)) return true;
+
+  uint32_t size = _textMax ? _textMax : 32;
+  while (size < len) size <<= 1;
+  if (size > 0xFFFF - 1) size = 0xFFFF - 1;
+
+  char *text = (char*)realloc(_text, size + 1);
+  if (!text) return false;
+
+  if (!_text) text[0] = 0;
+  _text = text;
+  _textMax = size;
+  return true;
+}
+
+/***************************************************************************************
+** Function name:           update
+** Description:             Re-calculate lines after the text changed at an offset
+***************************************************************************************/
+void TFT_eSPI_TextBox::update(uint16_t changed)
+{
+  if (!_gfx || (fontId() != _lineFont)) { layout(0); return; }
+
+  // Find line holding the change, the line before may now fit a word from it
+  uint16_t line = 0;
+  while ((line + 1 < _lineCount) && (_line[line + 1].start <= changed)) line++;
+  if (line) line--;
+
+  layout(line);
+}
+
+/***************************************************************************************
+** Function name:           layout
+** Description:             Break the text into lines from a line onwards
+***************************************************************************************/
+void TFT_eSPI_TextBox::layout(uint16_t line)
+{
+  if (!_gfx) return;
+
+  if (line >= _lineCount) line = _lineCount ? _lineCount - 1 : 0;
+  if (line == 0) _lineFont = fontId();
+
+  uint16_t p = line ? _line[line].start : 0;
+  _lineCount = line;
+  _measure.start = 0xFFFF; // Text or font may have changed
+
+  while (p < _textLen)
+  {
+    uint16_t end = p;     // End of the words that fit
+    uint16_t next;        // Start of the next line
+    bool     wrapped = false;
+
+    while (1)
+    {
+      uint16_t q = end;
+      while ((q < _textLen) && (_text[q] == ' ')) q++;
+      uint16_t w = q;
+      while ((q < _textLen) && (_text[q] != ' ') && (_text[q] != '\n')) q++;
+      if (q == w) break; // End of line or text
+
+      if ((q - p <= TEXTBOX_LINE_MAX) && (measure(p, q) <= _w)) { end = q; continue; }
+
+      wrapped = true;
+      if (end > p) break;
+
+      // A word that does not fit on its own is broken between characters
+      end = w;
+      uint16_t c = w;
+      while (c < q)
+      {
+        c++;
+        while ((c < q) && ((_text[c] & 0xC0) == 0x80)) c++; // UTF-8 continuation bytes
+        if ((c - p > TEXTBOX_LINE_MAX) || (measure(p, c) > _w)) break;
+        end = c;
+      }
+      if (end == w) // Show at least one character
+      {
+        end++;
+        while ((end < q) && ((_text[end] & 0xC0) == 0x80)) end++;
+      }
+      break;
+    }
+
+    // Spaces at a break and one '\n' are not part of either line
+    next = end;
+    while ((next < _textLen) && (_text[next] == ' ')) next++;
+    if (!wrapped && (next < _textLen) && (_text[next] == '\n')) next++;
+
+    if (_lineCount >= _lineMax)
+    {
+      uint16_t max = _lineMax ? _lineMax * 2 : 8;
+      textLine_t *l = (textLine_t*)realloc(_line, max * sizeof(textLine_t));
+      if (!l) break;
+      _line = l;
+      _lineMax = max;
+    }
+
+    _line[_lineCount].start = p;
+    _line[_lineCount].len   = end - p;
+    _lineCount++;
+
+    p = next;
+  }
+}
+
+/***************************************************************************************
+** Function name:           measure
+** Description:             Return the pixel width of the text between two offsets
+***************************************************************************************/
+// Lines are measured a word at a time, so the width of the words that fit is kept and
+// only the next word is added. This does not use (and evict) the text width caches
+int16_t TFT_eSPI_TextBox::measure(uint16_t start, uint16_t end)
+{
+  if ((start != _measure.start) || (end < _measure.end))
+  {
+    _measure.start  = _measure.end = start;
+    _measure.width  = 0;
+    _measure.last   = 0;
+    _measure.result = 0;
+  }
+
+  while (_measure.end < end)
+    _measure.result = _gfx->textWidthNext(_text, &_measure.end, end, &_measure.width, &_measure.last);
+
+  return _measure.result;
+}
+
+/***************************************************************************************
+** Function name:           lineHash
+** Description:             Return a hash of a line, 0 if there is no line (blank row)
+***************************************************************************************/
+uint32_t TFT_eSPI_TextBox::lineHash(uint16_t line)
+{
+  if (line >= _lineCount) return 0;
+
+  // FNV-1a, so an empty line differs from a blank row
+  uint32_t hash = 2166136261UL;
+  const char *c = _text + _line[line].start;
+  for (uint16_t i = 0; i < _line[line].len; i++) { hash ^= (uint8_t)c[i]; hash *= 16777619UL; }
+
+  return hash;
+}
+
+/***************************************************************************************
+** Function name:           fontId
+** Description:             Return a value that changes when the font or size changes
+***************************************************************************************/
+uint32_t TFT_eSPI_TextBox::fontId(void)
+{
+  // Font number and size, then height and a sample width for GFX and smooth fonts
+  uint32_t id = (_gfx->textfont << 24) ^ (_gfx->textsize << 16) ^ _gfx->fontHeight();
+  id ^= (uint32_t)_gfx->textWidth("Wi0") << 8;
+  id ^= _w << 20;
+#ifdef SMOOTH_FONT
+  if (_gfx->fontLoaded) id ^= 0x80000000UL;
+#endif
+
+  return id | 1; // 0 means no lines
+}
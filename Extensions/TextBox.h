@@ -0,0 +1,92 @@
+/***************************************************************************************
+// The following class creates a text box that lays text out within a rectangle with
+// word wrap, alignment and line spacing. It works with all font types: the font
+// selected in the TFT or Sprite when the box is drawn is used.
+// The line breaks are kept, so when the text changes only the lines from the change
+// onwards are re-calculated, and only the rows of the box that change are redrawn.
+***************************************************************************************/
+
+// Maximum number of bytes in one line of the box, longer lines are broken
+#ifndef TEXTBOX_LINE_MAX
+  #define TEXTBOX_LINE_MAX 128
+#endif
+
+class TFT_eSPI_TextBox {
+
+ public:
+  TFT_eSPI_TextBox(void);
+  ~TFT_eSPI_TextBox(void);
+
+  // Box area with top left corner at x,y. Rows in a Sprite are scrolled instead of redrawn
+  // when text moves up (e.g. a log view)
+  void     initTextBox(TFT_eSPI *gfx, int32_t x, int32_t y, int32_t w, int32_t h);
+  void     initTextBox(TFT_eSprite *spr, int32_t x, int32_t y, int32_t w, int32_t h);
+
+  // Text colour and background colour, the background is used to clear changed rows
+  void     setTextColor(uint16_t fgcolor, uint16_t bgcolor);
+
+  // Horizontal alignment in the box, TL_DATUM (default), TC_DATUM or TR_DATUM
+  void     setAlignment(uint8_t datum);
+
+  // Extra pixels between lines, can be negative
+  void     setLineSpacing(int16_t spacing);
+
+  // If true the last lines are shown (e.g. log view) and lines that have scrolled out of
+  // the box are discarded by appendText(), if false (default) the first lines are shown
+  void     setScroll(bool bottom);
+
+  // Set or add to the text, '\n' starts a new line. Return false if there is no RAM
+  bool     setText(const char *text);
+  bool     appendText(const char *text);
+  void     clear(void);
+
+  uint16_t getLineCount(void);    // Number of lines the text is broken into
+  uint16_t getRowCount(void);     // Number of lines that fit in the box
+
+  // Draw the rows that changed since the last draw, or all rows
+  void     draw(bool all = false);
+
+ private:
+  typedef struct
+  {
+    uint16_t start;               // Offset of line in text
+    uint16_t len;                 // Bytes in line, excluding spaces and '\n' at the break
+  } textLine_t;
+
+  typedef struct
+  {
+    uint16_t start, end;          // Offsets of text measured, text from the same start is
+    int32_t  width;               // measured by adding the characters that follow
+    uint16_t last;
+    int16_t  result;              // Width of the text
+  } measure_t;
+
+  bool     reserve(uint16_t len);               // Make sure the text buffer can hold len bytes
+  void     update(uint16_t changed);            // Re-calculate lines after a change at offset
+  void     layout(uint16_t line);               // Re-calculate the lines from line onwards
+  int16_t  measure(uint16_t start, uint16_t end); // Width of text between offsets, see _measure
+  uint32_t fontId(void);                        // Identifies the font and size being used
+  uint32_t lineHash(uint16_t line);             // Identifies the text of a line
+
+  TFT_eSPI    *_gfx;
+  TFT_eSprite *_spr;              // Set if the box is in a Sprite
+
+  int32_t  _x, _y, _w, _h;        // Box area
+  uint16_t _fgcolor, _bgcolor;
+  uint8_t  _datum;
+  int16_t  _spacing;
+  bool     _bottom;
+
+  char    *_text;                 // Text held by the box
+  uint16_t _textLen, _textMax;    // Bytes of text and size of buffer (less terminator)
+
+  textLine_t *_line;              // Line breaks
+  uint16_t _lineCount, _lineMax;
+  uint32_t _lineFont;             // fontId() used for the line breaks
+
+  measure_t _measure;             // Last text measured
+
+  uint32_t *_rowHash;             // Hash of the line drawn in each row of the box
+  uint16_t _rows;                 // Rows in _rowHash
+  bool     _redraw;               // All rows must be drawn
+};
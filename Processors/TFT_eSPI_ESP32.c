@@ -24,6 +24,20 @@
   #else
     spi_host_device_t spi_host = VSPI_HOST;
   #endif
+
+  // Transactions for a block queued by queueImageDMA(): window commands and pixels
+  typedef struct
+  {
+    spi_transaction_t trans[6];
+    dmaCallback       callback;
+    void             *arg;
+  } dmaBlock_t;
+
+  // Ring of blocks, the transactions are set up by initDMA() so only the window and
+  // pixel pointer change when a block is queued
+  dmaBlock_t dmaRing[DMA_QUEUE_BLOCKS];
+  uint32_t   dmaQueued = 0;      // Fence value of the last block queued
+  volatile uint32_t dmaDone = 0; // Count of queued blocks completed, updated by DMA interrupt
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -150,6 +164,8 @@ void TFT_eSPI::gpioMode(uint8_t gpio, uint8_t mode)
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   uint8_t colorBin[] = { (uint8_t) (color >> 8), (uint8_t) color };
   if(len) spi.writePattern(&colorBin[0], 2, 1); len--;
   while(len--) {WR_L; WR_H;}
@@ -161,6 +177,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   uint8_t *data = (uint8_t*)data_in;
 
   if(_swapBytes) {
@@ -181,6 +199,8 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 ** Description:             Write a block of pixels of the same colour
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+
+  STATS_ADD(pixels, len);
   
   uint32_t color32 = (color<<8 | color >>8)<<16 | (color<<8 | color >>8);
 
@@ -304,6 +324,8 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   if(_swapBytes) {
     pushSwapBytePixels(data_in, len);
     return;
@@ -358,6 +380,8 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   // Split out the colours
   uint32_t r = (color & 0xF800)>>8;
   uint32_t g = (color & 0x07E0)<<5;
@@ -428,6 +452,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
   // ILI9488 write macro is not endianess dependant, hence !_swapBytes
   if(!_swapBytes) { while ( len-- ) {tft_Write_16S(*data); data++;} }
@@ -454,6 +480,9 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 ** Description:             Write a block of pixels of the same colour
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+
+  STATS_ADD(pixels, len);
+
   if ( (color >> 8) == (color & 0x00FF) )
   { if (!len) return;
     tft_Write_16(color);
@@ -478,6 +507,8 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
   if(_swapBytes) { while ( len-- ) {tft_Write_16(*data); data++; } }
   else { while ( len-- ) {tft_Write_16S(*data); data++;} }
@@ -494,17 +525,17 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
 /***************************************************************************************
 ** Function name:           dmaBusy
-** Description:             Check if DMA is busy (currently blocking!)
+** Description:             Check if DMA is busy
 ***************************************************************************************/
 bool TFT_eSPI::dmaBusy(void)
 {
   if (!DMA_Enabled || !spiBusyCheck) return false;
-  //spi_transaction_t rtrans;
-  //bool trans_result=spi_device_polling_transmit(dmaHAL, &rtrans);
-  //return trans_result;
-  // This works but blocks
-  dmaWait();
-  return false;
+
+  // Collect the results of completed transactions without waiting
+  spi_transaction_t *rtrans;
+  while (spiBusyCheck && (spi_device_get_trans_result(dmaHAL, &rtrans, 0) == ESP_OK)) spiBusyCheck--;
+
+  return (spiBusyCheck != 0);
 }
 
 
@@ -530,11 +561,12 @@ void TFT_eSPI::dmaWait(void)
 ** Function name:           pushImageDMA
 ** Description:             Push pixels to TFT (len must be less than 32767)
 ***************************************************************************************/
-// This will byte swap the original image if setSwapBytes(true) was called by sketch.
-void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
+// The pixels are sent as they are, setSwapBytes() has no effect here so wireOrder is not used
+void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len, bool /*wireOrder*/)
 {
   if ((len == 0) || (!DMA_Enabled)) return;
   dmaWait();
+
   esp_err_t ret;
   static spi_transaction_t trans;
 
@@ -556,8 +588,9 @@ void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
 ** Function name:           pushImageDMA
 ** Description:             Push image to a window (w*h must be less than 65536)
 ***************************************************************************************/
-// This will clip and also swap bytes if setSwapBytes(true) was called by sketch
-void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer)
+// This will clip and also swap bytes if setSwapBytes(true) was called by sketch, unless
+// wireOrder is true
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer, bool wireOrder)
 {
   if ((x >= _width) || (y >= _height) || (!DMA_Enabled)) return;
 
@@ -580,14 +613,14 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
 
   dmaWait();
   
+  // Images already in TFT byte order are never swapped
+  bool swap = _swapBytes && !wireOrder;
+
   // If image is clipped, copy pixels into a contiguous block
   if ( (dw != w) || (dh != h) ) {
-    if(_swapBytes) {
+    if(swap) {
       for (int32_t yb = 0; yb < dh; yb++) {
-        for (int32_t xb = 0; xb < dw; xb++) {
-          uint32_t src = xb + dx + w * (yb + dy);
-          (buffer[xb + yb * dw] = image[src] << 8 | image[src] >> 8);
-        }
+        swapPixels(buffer + yb * dw, image + dx + w * (yb + dy), dw);
       }
     }
     else {
@@ -597,9 +630,9 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
     }
   }
   // else, if a buffer pointer has been provided copy whole image to the buffer
-  else if (buffer != image || _swapBytes) {
-    if(_swapBytes) {
-      for (uint32_t i = 0; i < len; i++) (buffer[i] = image[i] << 8 | image[i] >> 8);
+  else if (buffer != image || swap) {
+    if(swap) {
+      swapPixels(buffer, image, len);
     }
     else {
       memcpy(buffer, image, len*2);
@@ -645,6 +678,90 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
   spiBusyCheck = 6;
 }
 
+/***************************************************************************************
+** Function name:           queueImageDMA
+** Description:             Queue an image to a window without waiting, returns fence value
+***************************************************************************************/
+// The image must be in bus byte order and must not change until the block is complete
+uint32_t TFT_eSPI::queueImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, dmaCallback callback, void* arg)
+{
+  if ((x < 0) || (w < 1) || ((x + w) > _width) || (y >= _height) || (!DMA_Enabled)) return 0;
+
+  // Only whole rows are clipped so the pixels stay in one block
+  if (y < 0) { image -= y * w; h += y; y = 0; }
+  if ((y + h) > _height) h = _height - y;
+
+  if (h < 1) return 0;
+
+  // Collect completed transactions, the ring slot is free if the transactions still
+  // outstanding belong to the newer blocks
+  dmaBusy();
+  if (spiBusyCheck > 6 * (DMA_QUEUE_BLOCKS - 1)) return 0;
+
+  uint32_t fence = ++dmaQueued;
+  dmaBlock_t *block = &dmaRing[fence % DMA_QUEUE_BLOCKS];
+
+  block->callback = callback;
+  block->arg = arg;
+
+#ifdef CGRAM_OFFSET
+  x += colstart;
+  y += rowstart;
+#endif
+
+  spi_transaction_t *trans = block->trans;
+  trans[1].tx_data[0] = x >> 8;              //Start Col High
+  trans[1].tx_data[1] = x & 0xFF;            //Start Col Low
+  trans[1].tx_data[2] = (x + w - 1) >> 8;    //End Col High
+  trans[1].tx_data[3] = (x + w - 1) & 0xFF;  //End Col Low
+  trans[3].tx_data[0] = y >> 8;              //Start page high
+  trans[3].tx_data[1] = y & 0xFF;            //start page low
+  trans[3].tx_data[2] = (y + h - 1) >> 8;    //end page high
+  trans[3].tx_data[3] = (y + h - 1) & 0xFF;  //end page low
+  trans[5].tx_buffer = image;                //finally send the line data
+  trans[5].length = w * 2 * 8 * h;           //Data length, in bits
+
+  esp_err_t ret;
+  for (int i = 0; i < 6; i++)
+  {
+    ret = spi_device_queue_trans(dmaHAL, &trans[i], portMAX_DELAY);
+    assert(ret == ESP_OK);
+  }
+  spiBusyCheck += 6;
+
+  return fence;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaFence
+** Description:             Return the count of queued blocks completed
+***************************************************************************************/
+uint32_t TFT_eSPI::dmaFence(void)
+{
+  return dmaDone;
+}
+
+
+/***************************************************************************************
+** Function name:           dmaWaitFence
+** Description:             Wait until the queued block with a fence value is complete
+***************************************************************************************/
+void TFT_eSPI::dmaWaitFence(uint32_t fence)
+{
+  if (!DMA_Enabled) return;
+
+  // Results are returned in queue order, so wait for them until the block is complete
+  spi_transaction_t *rtrans;
+  esp_err_t ret;
+  while (((int32_t)(dmaDone - fence) < 0) && spiBusyCheck)
+  {
+    ret = spi_device_get_trans_result(dmaHAL, &rtrans, portMAX_DELAY);
+    assert(ret == ESP_OK);
+    spiBusyCheck--;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // Processor specific DMA initialisation
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -662,6 +779,23 @@ void IRAM_ATTR dc_callback(spi_transaction_t *spi_tx)
   else DC_C;
 }
 
+/***************************************************************************************
+** Function name:           dma_end_callback
+** Description:             Counts queued blocks as they complete
+***************************************************************************************/
+extern "C" void dma_end_callback();
+
+void IRAM_ATTR dma_end_callback(spi_transaction_t *spi_tx)
+{
+  // The pixel transaction of a queued block points at the block
+  if ((uint32_t)spi_tx->user > 1)
+  {
+    dmaBlock_t *block = (dmaBlock_t *)spi_tx->user;
+    dmaDone++;
+    if (block->callback) block->callback(block->arg);
+  }
+}
+
 /***************************************************************************************
 ** Function name:           initDMA
 ** Description:             Initialise the DMA engine - returns true if init OK
@@ -693,15 +827,34 @@ bool TFT_eSPI::initDMA(void)
     .input_delay_ns = 0,
     .spics_io_num = TFT_CS,
     .flags = 0,
-    .queue_size = 7,
+    .queue_size = 6 * DMA_QUEUE_BLOCKS + 1, // Transactions for the queued blocks
     .pre_cb = dc_callback, //Callback to handle D/C line
-    .post_cb = 0
+    .post_cb = dma_end_callback // Callback to count queued blocks
   };
   ret = spi_bus_initialize(spi_host, &buscfg, 1);
   ESP_ERROR_CHECK(ret);
   ret = spi_bus_add_device(spi_host, &devcfg, &dmaHAL);
   ESP_ERROR_CHECK(ret);
 
+  // Set up the window commands of the queued blocks, commands have DC low
+  for (int b = 0; b < DMA_QUEUE_BLOCKS; b++)
+  {
+    spi_transaction_t *trans = dmaRing[b].trans;
+    memset(trans, 0, 6 * sizeof(spi_transaction_t));
+    for (int i = 0; i < 5; i++)
+    {
+      trans[i].length = (i & 1) ? 8 * 4 : 8;
+      trans[i].user = (i & 1) ? (void *)1 : (void *)0;
+      trans[i].flags = SPI_TRANS_USE_TXDATA;
+    }
+    trans[0].tx_data[0] = TFT_CASET;         //Column Address Set
+    trans[2].tx_data[0] = TFT_PASET;         //Page address set
+    trans[4].tx_data[0] = TFT_RAMWR;         //memory write
+    trans[5].user = &dmaRing[b];             //Pixels have DC high, and identify the block
+  }
+  dmaQueued = 0;
+  dmaDone = 0;
+
   DMA_Enabled = true;
   spiBusyCheck = 0;
   return true;
@@ -312,6 +312,11 @@
     #define DMA_BUSY_CHECK
   #endif
 
+  // Number of blocks that can be queued by queueImageDMA(), each uses 6 SPI transactions
+  #ifndef DMA_QUEUE_BLOCKS
+    #define DMA_QUEUE_BLOCKS 4
+  #endif
+
   // ESP32 low level SPI writes for 8, 16 and 32 bit values
   // to avoid the function call overhead
   #define TFT_WRITE_BITS(D, B) \
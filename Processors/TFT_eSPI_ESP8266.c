@@ -83,6 +83,8 @@ uint8_t TFT_eSPI::readByte(void)
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   uint8_t colorBin[] = { (uint8_t) (color >> 8), (uint8_t) color };
   if(len) spi.writePattern(&colorBin[0], 2, 1); len--;
   while(len--) {WR_L; WR_H;}
@@ -94,6 +96,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   uint8_t *data = (uint8_t*)data_in;
   while ( len >=64 ) {spi.writePattern(data, 64, 1); data += 64; len -= 64; }
   if (len) spi.writePattern(data, len, 1);
@@ -118,6 +122,8 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   // Split out the colours
   uint8_t r = (color & 0xF800)>>8;
   uint8_t g = (color & 0x07E0)>>3;
@@ -182,6 +188,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
 
   // Send groups of 4 concatenated pixels
@@ -257,6 +265,8 @@ void TFT_eSPI::pushSwapBytePixels(const void* data_in, uint32_t len){
 //
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
 /*
 while (len>1) { tft_Write_32(color<<16 | color); len-=2;}
 if (len) tft_Write_16(color);
@@ -330,6 +340,8 @@ return;
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   if(_swapBytes) {
     pushSwapBytePixels(data_in, len);
     return;
@@ -66,6 +66,8 @@ void TFT_eSPI::end_SDA_Read(void)
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   while (len>1) {tft_Write_32D(color); len-=2;}
   if (len) {tft_Write_16(color);}
 }
@@ -76,6 +78,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
   if(_swapBytes) {
     while (len>1) {tft_Write_16(*data); data++; tft_Write_16(*data); data++; len -=2;}
@@ -151,6 +155,8 @@ uint8_t TFT_eSPI::readByte(void)
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   if(len) { tft_Write_16(color); len--; }
   while(len--) {WR_L; WR_H;}
 }
@@ -161,6 +167,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
 
   if (_swapBytes) while ( len-- ) {tft_Write_16S(*data); data++;}
@@ -177,6 +185,8 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   // Split out the colours
   uint8_t r = (color & 0xF800)>>8;
   uint8_t g = (color & 0x07E0)>>3;
@@ -191,6 +201,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
   if (_swapBytes) {
     while ( len-- ) {
@@ -221,6 +233,8 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   while ( len-- ) {tft_Write_16(color);}
 }
 
@@ -230,6 +244,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
 
   if (_swapBytes) while ( len-- ) {tft_Write_16(*data); data++;}
@@ -253,7 +269,7 @@ Minimal function set to support DMA:
 bool TFT_eSPI::initDMA(void)
 void TFT_eSPI::deInitDMA(void)
 bool TFT_eSPI::dmaBusy(void)
-void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
-void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image)
+void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len, bool wireOrder)
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer, bool wireOrder)
 
 */
@@ -0,0 +1,266 @@
+        ////////////////////////////////////////////////////
+        //       TFT_eSPI host (PC) driver functions      //
+        ////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Global variables
+////////////////////////////////////////////////////////////////////////////////////////
+
+// The bus model takes the place of the SPI port
+SPIClass spi;
+
+////////////////////////////////////////////////////////////////////////////////////////
+//                                BUS MODEL FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////
+
+/***************************************************************************************
+** Function name:           TFT_HostBus
+** Description:             Class constructor, allocates the GRAM model
+***************************************************************************************/
+TFT_HostBus::TFT_HostBus(void)
+{
+  gram = (uint16_t*)calloc(TFT_HOST_GRAM_SIZE * TFT_HOST_GRAM_SIZE, sizeof(uint16_t));
+
+  frequency = SPI_FREQUENCY;
+  madctl = 0;
+
+  dc = true;
+  cs = true;
+  cmd = TFT_NOP;
+  count = 0;
+  pixel = 0;
+
+  xs = xp = 0; xe = TFT_HOST_GRAM_SIZE - 1;
+  ys = yp = 0; ye = TFT_HOST_GRAM_SIZE - 1;
+
+  resetStats();
+}
+
+/***************************************************************************************
+** Function name:           ~TFT_HostBus
+** Description:             Class destructor
+***************************************************************************************/
+TFT_HostBus::~TFT_HostBus(void)
+{
+  if (gram) free(gram);
+}
+
+/***************************************************************************************
+** Function name:           transfer
+** Description:             Clock a byte over the bus, returns byte read from TFT
+***************************************************************************************/
+uint8_t TFT_HostBus::transfer(uint8_t data)
+{
+  stats.bytes++;
+
+  if (!dc) { command(data); return 0; }
+
+  // SPI is full duplex, bytes clocked after a read command are reads
+  if (cmd == TFT_RAMRD) return readData();
+
+  writeData(data);
+  return 0;
+}
+
+/***************************************************************************************
+** Function name:           command
+** Description:             Decode a command byte
+***************************************************************************************/
+void TFT_HostBus::command(uint8_t c)
+{
+  stats.cmdBytes++;
+  stats.commands++;
+
+  cmd   = c;
+  count = 0;
+  pixel = 0;
+
+  switch (c) {
+    case TFT_CASET:
+      stats.caset++;
+      break;
+    case TFT_PASET:
+      stats.paset++;
+      break;
+    case TFT_RAMWR:
+      stats.ramwr++;
+      xp = xs; yp = ys; // Memory write starts at the window origin
+      break;
+    case TFT_RAMRD:
+      stats.ramrd++;
+      xp = xs; yp = ys;
+      break;
+    case TFT_SWRST:
+      xs = 0; xe = TFT_HOST_GRAM_SIZE - 1;
+      ys = 0; ye = TFT_HOST_GRAM_SIZE - 1;
+      break;
+  }
+}
+
+/***************************************************************************************
+** Function name:           writeData
+** Description:             Decode a parameter or pixel byte
+***************************************************************************************/
+void TFT_HostBus::writeData(uint8_t d)
+{
+  stats.dataBytes++;
+
+  if (cmd == TFT_RAMWR) {
+    pixel = (pixel << 8) | d;
+  #if defined (ILI9488_DRIVER) // 18 bit colour sent as 3 bytes
+    if (++count < 3) return;
+    pixel = ((pixel >> 8) & 0xF800) | ((pixel >> 5) & 0x07E0) | ((pixel >> 3) & 0x001F);
+  #else
+    if (++count < 2) return;
+  #endif
+    count = 0;
+
+    if ((xp < TFT_HOST_GRAM_SIZE) && (yp < TFT_HOST_GRAM_SIZE))
+      gram[xp + yp * TFT_HOST_GRAM_SIZE] = pixel;
+    pixel = 0;
+    stats.pixels++;
+
+    // Advance the address pointer, wrapping within the window like the TFT does
+    if (++xp > xe) { xp = xs; if (++yp > ye) yp = ys; }
+    return;
+  }
+
+  if (count < 4) param[count] = d;
+  count++;
+
+  if (count == 4) {
+    if (cmd == TFT_CASET) { xs = (param[0] << 8) | param[1]; xe = (param[2] << 8) | param[3]; }
+    else if (cmd == TFT_PASET) { ys = (param[0] << 8) | param[1]; ye = (param[2] << 8) | param[3]; }
+  }
+
+  if (cmd == TFT_MADCTL) madctl = d;
+}
+
+/***************************************************************************************
+** Function name:           readData
+** Description:             Return next byte of a GRAM read, first byte is a dummy
+***************************************************************************************/
+uint8_t TFT_HostBus::readData(void)
+{
+  stats.readBytes++;
+
+  if (count++ == 0) return 0; // Dummy byte
+
+  // GRAM is read back as 3 bytes per pixel with colours in the top 6 bits
+  uint8_t phase = (count - 2) % 3;
+  if (phase == 0) {
+    pixel = readGRAM(xp, yp);
+    if (++xp > xe) { xp = xs; if (++yp > ye) yp = ys; }
+    return (pixel & 0xF800) >> 8;
+  }
+  if (phase == 1) return (pixel & 0x07E0) >> 3;
+  return (pixel & 0x001F) << 3;
+}
+
+/***************************************************************************************
+** Function name:           readGRAM
+** Description:             Read the 565 colour held at a GRAM location
+***************************************************************************************/
+uint16_t TFT_HostBus::readGRAM(int32_t x, int32_t y)
+{
+  if ((x < 0) || (y < 0) || (x >= TFT_HOST_GRAM_SIZE) || (y >= TFT_HOST_GRAM_SIZE)) return 0;
+
+  return gram[x + y * TFT_HOST_GRAM_SIZE];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+#if defined (ILI9488_DRIVER) // For 24 bit SPI colour TFT
+////////////////////////////////////////////////////////////////////////////////////////
+
+/***************************************************************************************
+** Function name:           pushBlock - for host and 3 byte RGB display
+** Description:             Write a block of pixels of the same colour
+***************************************************************************************/
+void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
+{
+  STATS_ADD(pixels, len);
+
+  // Split out the colours
+  uint8_t r = (color & 0xF800)>>8;
+  uint8_t g = (color & 0x07E0)>>3;
+  uint8_t b = (color & 0x001F)<<3;
+
+  while ( len-- ) {tft_Write_8(r); tft_Write_8(g); tft_Write_8(b);}
+}
+
+/***************************************************************************************
+** Function name:           pushPixels - for host and 3 byte RGB display
+** Description:             Write a sequence of pixels
+***************************************************************************************/
+void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+
+  STATS_ADD(pixels, len);
+
+  uint16_t *data = (uint16_t*)data_in;
+  if (_swapBytes) {
+    while ( len-- ) {
+      uint16_t color = *data >> 8 | *data << 8;
+      tft_Write_8((color & 0xF800)>>8);
+      tft_Write_8((color & 0x07E0)>>3);
+      tft_Write_8((color & 0x001F)<<3);
+      data++;
+    }
+  }
+  else {
+    while ( len-- ) {
+      tft_Write_8((*data & 0xF800)>>8);
+      tft_Write_8((*data & 0x07E0)>>3);
+      tft_Write_8((*data & 0x001F)<<3);
+      data++;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+#else //                   Standard SPI 16 bit colour TFT
+////////////////////////////////////////////////////////////////////////////////////////
+
+/***************************************************************************************
+** Function name:           pushBlock - for host
+** Description:             Write a block of pixels of the same colour
+***************************************************************************************/
+void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+
+  STATS_ADD(pixels, len);
+
+  while ( len-- ) {tft_Write_16(color);}
+}
+
+/***************************************************************************************
+** Function name:           pushPixels - for host
+** Description:             Write a sequence of pixels
+***************************************************************************************/
+void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
+
+  STATS_ADD(pixels, len);
+
+  uint16_t *data = (uint16_t*)data_in;
+
+  if (_swapBytes) while ( len-- ) {tft_Write_16(*data); data++;}
+  else while ( len-- ) {tft_Write_16S(*data); data++;}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+#endif // End of display interface specific functions
+////////////////////////////////////////////////////////////////////////////////////////
+
+/***************************************************************************************
+** Function name:           read byte  - supports class functions
+** Description:             Read a byte from the bus model
+***************************************************************************************/
+uint8_t TFT_eSPI::readByte(void)
+{
+  return tft_Read_8();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+//                                DMA FUNCTIONS
+////////////////////////////////////////////////////////////////////////////////////////
+
+//                DMA is not modelled for the host
@@ -0,0 +1,204 @@
+        ////////////////////////////////////////////////////
+        //       TFT_eSPI host (PC) driver functions      //
+        ////////////////////////////////////////////////////
+
+// This driver allows the library to run on a host computer (e.g. Linux) without a
+// board or display attached. The SPI bus is replaced by a model of the display
+// controller which decodes the CASET, PASET, RAMWR and RAMRD commands into an in
+// memory copy of the controller GRAM and counts the bus traffic. This makes it
+// possible to check rendering results and measure the bus cost of each frame.
+//
+// The host build must define TFT_HOST (e.g. -DTFT_HOST compiler flag) so that the
+// Arduino SPI library is not included, and the host Arduino core must provide the
+// Arduino.h and Print.h headers. The font tables hold pointers, so pgm_read_dword()
+// must return a pointer sized value on 64 bit hosts.
+//
+// 8 bit parallel interface to TFT is not supported for the host
+
+#ifndef _TFT_eSPI_HOSTH_
+#define _TFT_eSPI_HOSTH_
+
+// Processor ID reported by getSetup()
+#define PROCESSOR_ID 0x0001
+
+// Include processor specific header
+#include <string.h>
+
+// Processor specific code used by SPI bus transaction startWrite and endWrite functions
+#define SET_BUS_WRITE_MODE // Not used
+#define SET_BUS_READ_MODE  // Not used
+
+// Code to check if DMA is busy, used by SPI bus transaction startWrite and endWrite functions
+#define DMA_BUSY_CHECK // Not used so leave blank
+
+// To be safe, SUPPORT_TRANSACTIONS is assumed mandatory
+#if !defined (SUPPORT_TRANSACTIONS)
+  #define SUPPORT_TRANSACTIONS
+#endif
+
+// Initialise processor specific SPI functions, used by init()
+#define INIT_TFT_DATA_BUS
+
+// x86 hosts expand 1 bit per pixel images 8 pixels at a time with SSE2, see expandBits()
+#if defined (__SSE2__)
+  #include <emmintrin.h>
+  #define EXPAND_BITS_SSE2
+#endif
+
+// The GRAM model is square so it holds the image in all rotations, the extra
+// lines allow for CGRAM offsets (e.g. 240x240 ST7789 uses a 240x320 GRAM)
+#ifndef TFT_HOST_GRAM_SIZE
+  #define TFT_HOST_GRAM_SIZE ((TFT_WIDTH > TFT_HEIGHT ? TFT_WIDTH : TFT_HEIGHT) + 80)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Bus model of the display controller, takes the place of the Arduino SPIClass
+////////////////////////////////////////////////////////////////////////////////////////
+// Counters for the traffic that would have been sent over the bus
+typedef struct
+{
+  uint32_t bytes;        // Total bytes clocked over the bus
+  uint32_t cmdBytes;     // Command bytes written (DC low)
+  uint32_t dataBytes;    // Parameter and pixel bytes written (DC high)
+  uint32_t readBytes;    // Bytes read from the TFT
+  uint32_t transactions; // Number of times CS went low
+  uint32_t dcToggles;    // Number of times DC changed between command and data
+  uint32_t commands;     // All commands
+  uint32_t caset;        // Column address set commands
+  uint32_t paset;        // Page (row) address set commands
+  uint32_t ramwr;        // GRAM write commands
+  uint32_t ramrd;        // GRAM read commands
+  uint32_t pixels;       // Pixels written to GRAM
+} busStats_t;
+
+class TFT_HostBus {
+
+ public:
+
+  TFT_HostBus(void);
+  ~TFT_HostBus(void);
+
+  // SPIClass compatible functions used by the library
+  void     begin(void) { }
+  void     end(void) { }
+  void     setFrequency(uint32_t freq) { frequency = freq; }
+
+  uint8_t  transfer(uint8_t data);
+  uint16_t transfer16(uint16_t data) { uint16_t r = transfer(data >> 8) << 8; return r | transfer(data); }
+
+  // Control line models, driven by the DC_C, DC_D, CS_L and CS_H macros
+  void     dcLow(void)  { if (dc)  { dc = false; stats.dcToggles++; } }
+  void     dcHigh(void) { if (!dc) { dc = true;  stats.dcToggles++; } }
+  void     csLow(void)  { if (cs)  { cs = false; stats.transactions++; } }
+  void     csHigh(void) { cs = true; }
+
+  // Read the 565 colour held in the modelled GRAM at column x and page (row) y
+  uint16_t readGRAM(int32_t x, int32_t y);
+
+  // Clear the traffic counters, typically at the start of each frame
+  void     resetStats(void) { memset(&stats, 0, sizeof(stats)); }
+
+  busStats_t stats;      // Bus traffic counters, read these to measure rendering cost
+
+  uint16_t *gram;        // Modelled GRAM (565 colours, TFT_HOST_GRAM_SIZE square)
+  uint32_t frequency;    // Last SPI clock rate set, can be used to estimate bus time
+  uint8_t  madctl;       // Last memory access control value sent by the driver
+
+ private:
+
+  void     command(uint8_t c);
+  void     writeData(uint8_t d);
+  uint8_t  readData(void);
+
+  bool     dc, cs;               // Control line states
+  uint8_t  cmd;                  // Command being executed
+  uint8_t  param[4];             // Buffered address parameters
+  uint32_t count;                // Bytes received/sent since the command
+  uint32_t pixel;                // Pixel bytes being assembled or read back
+
+  int32_t  xs, xe, ys, ye;       // Address window
+  int32_t  xp, yp;               // GRAM address pointer within the window
+
+};
+
+typedef TFT_HostBus SPIClass;
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Define the DC (TFT Data/Command or Register Select (RS))pin drive code
+////////////////////////////////////////////////////////////////////////////////////////
+#define DC_C spi.dcLow()
+#define DC_D spi.dcHigh()
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Define the CS (TFT chip select) pin drive code
+////////////////////////////////////////////////////////////////////////////////////////
+#define CS_L spi.csLow()
+#define CS_H spi.csHigh()
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Define the touch screen chip select pin drive code
+////////////////////////////////////////////////////////////////////////////////////////
+#define T_CS_L // No macro allocated so it generates no code
+#define T_CS_H // No macro allocated so it generates no code
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Make sure TFT_MISO is defined if not used to avoid an error message
+////////////////////////////////////////////////////////////////////////////////////////
+#ifndef TFT_MISO
+  #define TFT_MISO -1
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Macros to write commands/pixel colour data to an ILI9488 TFT
+////////////////////////////////////////////////////////////////////////////////////////
+#if  defined (ILI9488_DRIVER) // 16 bit colour converted to 3 bytes for 18 bit RGB
+
+  // Write 8 bits to TFT
+  #define tft_Write_8(C)   spi.transfer(C)
+
+  // Convert 16 bit colour to 18 bit and write in 3 bytes
+  #define tft_Write_16(C)  spi.transfer(((C) & 0xF800)>>8); \
+                           spi.transfer(((C) & 0x07E0)>>3); \
+                           spi.transfer(((C) & 0x001F)<<3)
+
+  // Convert swapped byte 16 bit colour to 18 bit and write in 3 bytes
+  #define tft_Write_16S(C) spi.transfer((C) & 0xF8); \
+                           spi.transfer(((C) & 0xE000)>>11 | ((C) & 0x07)<<5); \
+                           spi.transfer(((C) & 0x1F00)>>5)
+  // Write 32 bits to TFT
+  #define tft_Write_32(C)  spi.transfer16((C)>>16); spi.transfer16((uint16_t)(C))
+
+  // Write two address coordinates
+  #define tft_Write_32C(C,D) spi.transfer16(C); spi.transfer16(D)
+
+  // Write same value twice
+  #define tft_Write_32D(C) spi.transfer16(C); spi.transfer16(C)
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Macros to write commands/pixel colour data to other displays
+////////////////////////////////////////////////////////////////////////////////////////
+#else
+  #define tft_Write_8(C)   spi.transfer(C)
+  #define tft_Write_16(C)  spi.transfer16(C)
+  #define tft_Write_16S(C) spi.transfer16(((C)>>8) | ((C)<<8))
+
+  #define tft_Write_32(C) \
+  tft_Write_16((uint16_t) ((C)>>16)); \
+  tft_Write_16((uint16_t) ((C)>>0))
+
+  #define tft_Write_32C(C,D) \
+  tft_Write_16((uint16_t) (C)); \
+  tft_Write_16((uint16_t) (D))
+
+  #define tft_Write_32D(C) \
+  tft_Write_16((uint16_t) (C)); \
+  tft_Write_16((uint16_t) (C))
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Macros to read from display using SPI
+////////////////////////////////////////////////////////////////////////////////////////
+#define tft_Read_8() spi.transfer(0)
+
+
+#endif // Header end
@@ -19,6 +19,12 @@
 #ifdef STM32_DMA
   // DMA HAL handle
   DMA_HandleTypeDef dmaHal;
+
+  // Bytes still to be sent after the current DMA segment, the DMA count is 16 bits so
+  // longer transfers are chained in segments from the DMA interrupt handler
+  uint8_t* volatile dmaNext;
+  volatile uint32_t dmaRemaining = 0;
+  volatile bool     dmaFailed = false; // A segment could not be started or sent
 #endif
 
   // Buffer for SPI transmit byte padding and byte order manipulation
@@ -81,6 +87,9 @@ void TFT_eSPI::end_SDA_Read(void)
 ** Description:             Write a block of pixels of the same colour
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
+
+  STATS_ADD(pixels, len);
+
   // Loop unrolling improves speed dramtically graphics test  0.634s => 0.374s
   while (len>31) {
     // 32D macro writes 16 bits twice
@@ -109,6 +118,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len){
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len){
 
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
 
   if(_swapBytes) {
@@ -222,6 +233,8 @@ uint8_t TFT_eSPI::readByte(void)
 ***************************************************************************************/
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   if(len) { tft_Write_16(color); len--; }
   while(len--) {WR_L; WR_H;}
 }
@@ -232,6 +245,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
 
   if (_swapBytes) while ( len-- ) { tft_Write_16S(*data); data++;}
@@ -249,6 +264,8 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 #define BUF_SIZE 240*3
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   uint8_t col[BUF_SIZE];
   // Always using swapped bytes is a peculiarity of this function...
   //color = color>>8 | color<<8;
@@ -284,6 +301,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
 
   if(_swapBytes) {
@@ -319,6 +338,8 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 #define BUF_SIZE 480
 void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   uint16_t col[BUF_SIZE];
   // Always using swapped bytes is a peculiarity of this function...
   uint16_t swapColor = color>>8 | color<<8;
@@ -344,6 +365,8 @@ void TFT_eSPI::pushBlock(uint16_t color, uint32_t len)
 ***************************************************************************************/
 void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 {
+  STATS_ADD(pixels, len);
+
   uint16_t *data = (uint16_t*)data_in;
   if(_swapBytes) {
     uint16_t col[BUF_SIZE]; // Buffer for swapped bytes
@@ -384,37 +407,94 @@ void TFT_eSPI::pushPixels(const void* data_in, uint32_t len)
 // or  "while( tft.dmaBusy() ) {Do-something-useful;}"
 bool TFT_eSPI::dmaBusy(void)
 {
+  // Busy until the last segment has been started and the SPI has finished sending it
+  if (dmaRemaining) return true;
   //return (dmaHal.State == HAL_DMA_STATE_BUSY);  // Do not use, SPI may still be busy
   return (spiHal.State == HAL_SPI_STATE_BUSY_TX); // Check if SPI Tx is busy
 }
 
 
 /***************************************************************************************
-** Function name:           pushImageDMA
-** Description:             Push pixels to TFT (len must be less than 32767)
+** Function name:           dmaSegment
+** Description:             Start DMA for the next segment of the pixels to send
+***************************************************************************************/
+static void dmaSegment(void)
+{
+  uint32_t len = dmaRemaining;
+  if (len > 0xFFFE) len = 0xFFFE; // DMA count is 16 bits, keep segments to whole pixels
+
+  uint8_t* data = dmaNext;
+  dmaNext = data + len;
+  dmaRemaining -= len;
+
+  // Abandon the rest of the pixels if the segment is not started, else dmaBusy() never ends
+  if (HAL_SPI_Transmit_DMA(&spiHal, data, len) != HAL_OK)
+  {
+    dmaRemaining = 0;
+    dmaFailed = true;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           dmaChain
+** Description:             Called by the DMA interrupt handler to start the next segment
 ***************************************************************************************/
-// This will byte swap the original image if setSwapBytes(true) was called by sketch.
-void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len)
+static void dmaChain(void)
+{
+  // Half transfer interrupts leave the SPI busy, the segment is complete when it is ready
+  if (!dmaRemaining || (spiHal.State != HAL_SPI_STATE_READY)) return;
+
+  // Abandon the rest of the pixels if the transfer failed
+  if (spiHal.ErrorCode != HAL_SPI_ERROR_NONE)
+  {
+    dmaRemaining = 0;
+    dmaFailed = true;
+  }
+  else dmaSegment();
+}
+
+
+/***************************************************************************************
+** Function name:           dmaError
+** Description:             Return true if a DMA transfer failed since the last call
+***************************************************************************************/
+bool TFT_eSPI::dmaError(void)
+{
+  bool failed = dmaFailed;
+  dmaFailed = false;
+  return failed;
+}
+
+
+/***************************************************************************************
+** Function name:           pushPixelsDMA
+** Description:             Push pixels to TFT
+***************************************************************************************/
+// This will byte swap the original image if setSwapBytes(true) was called by sketch,
+// unless wireOrder is true.
+void TFT_eSPI::pushPixelsDMA(uint16_t* image, uint32_t len, bool wireOrder)
 {
   if (len == 0) return;
 
   // Wait for any current DMA transaction to end
-  while (spiHal.State == HAL_SPI_STATE_BUSY_TX); // Check if SPI Tx is busy
+  while (dmaBusy());
 
-  if(_swapBytes) {
-    for (uint32_t i = 0; i < len; i++) (image[i] = image[i] << 8 | image[i] >> 8);
-  }
+  if (_swapBytes && !wireOrder) swapPixels(image, image, len);
 
-  HAL_SPI_Transmit_DMA(&spiHal, (uint8_t*)image, len << 1);
+  dmaNext = (uint8_t*)image;
+  dmaRemaining = len << 1;
+  dmaSegment();
 }
 
 
 /***************************************************************************************
 ** Function name:           pushImageDMA
-** Description:             Push image to a window (w*h must be less than 65536)
+** Description:             Push image to a window
 ***************************************************************************************/
-// This will clip and also swap bytes if setSwapBytes(true) was called by sketch
-void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer)
+// This will clip and also swap bytes if setSwapBytes(true) was called by sketch, unless
+// wireOrder is true
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* image, uint16_t* buffer, bool wireOrder)
 {
   if ((x >= _width) || (y >= _height)) return;
 
@@ -435,16 +515,16 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
 
   uint32_t len = dw*dh;
 
-  while (spiHal.State == HAL_SPI_STATE_BUSY_TX); // Check if SPI Tx is busy
+  while (dmaBusy()); // Wait for all segments of the last image to be sent
+
+  // Images already in TFT byte order are never swapped
+  bool swap = _swapBytes && !wireOrder;
 
   // If image is clipped, copy pixels into a contiguous block
   if ( (dw != w) || (dh != h) ) {
-    if(_swapBytes) {
+    if(swap) {
       for (int32_t yb = 0; yb < dh; yb++) {
-        for (int32_t xb = 0; xb < dw; xb++) {
-          uint32_t src = xb + dx + w * (yb + dy);
-          (buffer[xb + yb * dw] = image[src] << 8 | image[src] >> 8);
-        }
+        swapPixels(buffer + yb * dw, image + dx + w * (yb + dy), dw);
       }
     }
     else {
@@ -454,9 +534,9 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
     }
   }
   // else, if a buffer pointer has been provided copy whole image to the buffer
-  else if (buffer != image || _swapBytes) {
-    if(_swapBytes) {
-      for (uint32_t i = 0; i < len; i++) (buffer[i] = image[i] << 8 | image[i] >> 8);
+  else if (buffer != image || swap) {
+    if(swap) {
+      swapPixels(buffer, image, len);
     }
     else {
       memcpy(buffer, image, len*2);
@@ -465,16 +545,11 @@ void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t
 
   setWindow(x, y, x + dw - 1, y + dh - 1);
 
-  // DMA byte count for transmit is only 16 bits maximum, so to avoid this constraint
-  // small transfers are performed using a blocking call until DMA capacity is reached.
-  // User sketch can prevent blocking by managing pixel count and splitting into blocks
-  // of 32767 pixels maximum. (equivalent to an area of ~320 x 100 pixels)
-  while(len>0x7FFF) { // Transfer 16 bit pixels in blocks if len*2 over 65534 bytes
-    HAL_SPI_Transmit(&spiHal, (uint8_t*)buffer, 0x800<<1, HAL_MAX_DELAY);
-    len -= 0x800; buffer+= 0x800; // Arbitrarily send 1K pixel blocks (2Kbytes)
-  }
-  // Send remaining pixels using DMA (max 65534 bytes)
-  HAL_SPI_Transmit_DMA(&spiHal, (uint8_t*)buffer, len << 1);
+  // DMA byte count for transmit is only 16 bits maximum, so images over 32767 pixels
+  // are sent in segments, each started by the DMA interrupt when the last one ends
+  dmaNext = (uint8_t*)buffer;
+  dmaRemaining = len << 1;
+  dmaSegment();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -492,6 +567,8 @@ void DMA2_Stream3_IRQHandler(void)
 {
   // Call the default end of buffer handler
   HAL_DMA_IRQHandler(&dmaHal);
+  // Start the next segment if there is one
+  dmaChain();
 }
 
 /***************************************************************************************
@@ -536,6 +613,8 @@ void DMA1_Channel3_IRQHandler(void)
 {
   // Call the default end of buffer handler
   HAL_DMA_IRQHandler(&dmaHal);
+  // Start the next segment if there is one
+  dmaChain();
 }
 //*/
 /***************************************************************************************
@@ -575,6 +654,7 @@ bool TFT_eSPI::initDMA(void)
 ***************************************************************************************/
 void TFT_eSPI::deInitDMA(void)
 {
+  dmaRemaining = 0;
   HAL_DMA_DeInit(&dmaHal);
   DMA_Enabled = false;
 }
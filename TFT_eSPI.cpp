@@ -22,16 +22,24 @@
   #include "Processors/TFT_eSPI_ESP8266.c"
 #elif defined (STM32) // (_VARIANT_ARDUINO_STM32_) stm32_def.h
   #include "Processors/TFT_eSPI_STM32.c"
+#elif defined (TFT_HOST)
+  #include "Processors/TFT_eSPI_Host.c"
 #else
   #include "Processors/TFT_eSPI_Generic.c"
 #endif
 
 
+#ifndef NO_COLOR_LUT
+// 8 bit colour to 565 colour table, filled by init()
+static uint16_t COLOR_LUT_ATTR colorLUT8[256];
+#endif
+
 /***************************************************************************************
 ** Function name:           begin_tft_write (was called spi_begin)
 ** Description:             Start SPI transaction for writes and select TFT
 ***************************************************************************************/
 inline void TFT_eSPI::begin_tft_write(void){
+  STATS_WRITE_BEGIN;
 #if defined (SPI_HAS_TRANSACTION) && defined (SUPPORT_TRANSACTIONS) && !defined(TFT_PARALLEL_8_BIT)
   if (locked) {
     locked = false;
@@ -61,6 +69,7 @@ inline void TFT_eSPI::end_tft_write(void){
 #else
   if(!inTransaction) {CS_H;}
 #endif
+  STATS_WRITE_END;
 }
 
 /***************************************************************************************
@@ -184,6 +193,9 @@ TFT_eSPI::TFT_eSPI(int16_t w, int16_t h)
   textbgcolor = bitmap_bg = 0x0000; // Black
   padX = 0;             // No padding
   isDigits   = false;   // No bounding box adjustment
+  _widthCache = nullptr; // Allocated when first needed
+  _widthTick  = 0;
+  _pinWidth   = false;
   textwrapX  = true;    // Wrap text at end of line when using print stream
   textwrapY  = false;   // Wrap text at bottom of screen when using print stream
   textdatum = TL_DATUM; // Top Left text alignment is default
@@ -214,6 +226,11 @@ TFT_eSPI::TFT_eSPI(int16_t w, int16_t h)
   _xpivot = 0;
   _ypivot = 0;
 
+#ifdef TFT_eSPI_STATS
+  _statsBusy = false;
+  resetStats();
+#endif
+
   cspinmask = 0;
   dcpinmask = 0;
   wrpinmask = 0;
@@ -330,6 +347,14 @@ void TFT_eSPI::init(uint8_t tc)
     digitalWrite(TFT_DC, HIGH); // Data/Command high = data mode
 #endif
 
+#ifndef NO_COLOR_LUT
+    // Build the 8 bit colour table, entries are in bus byte order
+    for (uint32_t i = 0; i < 256; i++) {
+      uint16_t color = color8to16(i);
+      colorLUT8[i] = (color >> 8) | (color << 8);
+    }
+#endif
+
     _booted = false;
     end_tft_write();
   } // end of: if just _booted
@@ -1132,123 +1157,44 @@ void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t *da
 
   if (bpp8)
   {
-    bool swap = _swapBytes; _swapBytes = false;
-
-    uint8_t  blue[] = {0, 11, 21, 31}; // blue 2 to 5 bit colour lookup table
-
-    _lastColor = -1; // Set to illegal value
-
-    // Used to store last shifted colour
-    uint8_t msbColor = 0;
-    uint8_t lsbColor = 0;
+    // With a colour map the pixels are indexes to 256 colours, otherwise 332 colours.
+    // The 332 line buffer is in bus byte order, colour map entries are swapped as sent
+    bool swap = _swapBytes; _swapBytes = (cmap != nullptr);
 
     data += dx + dy * w;
     while (dh--) {
-      uint32_t len = dw;
-      uint8_t* ptr = data;
-      uint8_t* linePtr = (uint8_t*)lineBuf;
-
-      while(len--) {
-        uint32_t color = *ptr++;
-
-        // Shifts are slow so check if colour has changed first
-        if (color != _lastColor) {
-          //          =====Green=====     ===============Red==============
-          msbColor = (color & 0x1C)>>2 | (color & 0xC0)>>3 | (color & 0xE0);
-          //          =====Green=====    =======Blue======
-          lsbColor = (color & 0x1C)<<3 | blue[color & 0x03];
-          _lastColor = color;
-        }
-
-       *linePtr++ = msbColor;
-       *linePtr++ = lsbColor;
-      }
-
+      convert8bpp(lineBuf, data, dw, cmap);
       pushPixels(lineBuf, dw);
-
       data += w;
     }
     _swapBytes = swap; // Restore old value
   }
   else if (cmap != nullptr) // Must be 4bpp
   {
-    bool swap = _swapBytes; _swapBytes = true;
+    bool swap = _swapBytes; _swapBytes = false; // Line buffer is in bus byte order
 
-    w = (w+1) & 0xFFFE;   // if this is a sprite, w will already be even; this does no harm.
-    bool splitFirst = (dx & 0x01) != 0; // split first means we have to push a single px from the left of the sprite / image
+    uint16_t pal[16]; // Colour map in bus byte order
+    for (uint32_t i = 0; i < 16; i++) pal[i] = (cmap[i] >> 8) | (cmap[i] << 8);
 
-    if (splitFirst) {
-      data += ((dx - 1 + dy * w) >> 1);
-    }
-    else {
-      data += ((dx + dy * w) >> 1);
-    }
+    w = (w+1) & 0xFFFE;   // if this is a sprite, w will already be even; this does no harm.
 
     while (dh--) {
-      uint32_t len = dw;
-      uint8_t * ptr = data;
-      uint16_t *linePtr = lineBuf;
-      uint8_t colors; // two colors in one byte
-      uint16_t index;
-
-      if (splitFirst) {
-        colors = *ptr;
-        index = (colors & 0x0F);
-        *linePtr++ = cmap[index];
-        len--;
-        ptr++;
-      }
-
-      while (len--)
-      {
-        colors = *ptr;
-        index = ((colors & 0xF0) >> 4) & 0x0F;
-        *linePtr++ = cmap[index];
-
-        if (len--)
-        {
-          index = colors & 0x0F;
-          *linePtr++ = cmap[index];
-        } else {
-          break;  // nothing to do here
-        }
-
-        ptr++;
-      }
-
+      convert4bpp(lineBuf, data, dx + dy * w, dw, pal);
       pushPixels(lineBuf, dw);
-      data += (w >> 1);
+      dy++;
     }
     _swapBytes = swap; // Restore old value
   }
   else // Must be 1bpp
   {
-    bool swap = _swapBytes; _swapBytes = false;
-    while (dh--) {
-      w =  (w+7) & 0xFFF8;
-
-      int32_t len = dw;
-      uint8_t* ptr = data;
-      uint8_t* linePtr = (uint8_t*)lineBuf;
-      uint8_t  bits = 8;
-      while(len>0) {
-        if (len < 8) bits = len;
-        uint32_t xp = dx;
-        for (uint16_t i = 0; i < bits; i++) {
-          uint8_t col = (ptr[(xp + dy * w)>>3] << (xp & 0x7)) & 0x80;
-          if (col) {*linePtr++ = bitmap_fg>>8; *linePtr++ = (uint8_t) bitmap_fg;}
-          else     {*linePtr++ = bitmap_bg>>8; *linePtr++ = (uint8_t) bitmap_bg;}
-          //if (col) drawPixel((dw-len)+xp,h-dh,bitmap_fg);
-          //else     drawPixel((dw-len)+xp,h-dh,bitmap_bg);
-          xp++;
-        }
-        ptr++;
-        len -= 8;
-      }
+    bool swap = _swapBytes; _swapBytes = true; // Line buffer holds 565 colours
 
+    w = (w+7) & 0xFFF8;
+    data += (dy * w) >> 3;
+    while (dh--) {
+      expandBits(lineBuf, data, dx, dw, bitmap_fg, bitmap_bg, false);
       pushPixels(lineBuf, dw);
-
-      dy++;
+      data += w >> 3;
     }
     _swapBytes = swap; // Restore old value
   }
@@ -1288,59 +1234,26 @@ void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t *da
   uint16_t  lineBuf[dw];
 
   if (bpp8) { // 8 bits per pixel
-    bool swap = _swapBytes; _swapBytes = false;
+    // With a colour map the pixels are indexes to 256 colours, otherwise 332 colours.
+    // The 332 line buffer is in bus byte order, colour map entries are swapped as sent
+    bool swap = _swapBytes; _swapBytes = (cmap != nullptr);
 
     data += dx + dy * w;
 
-    uint8_t  blue[] = {0, 11, 21, 31}; // blue 2 to 5 bit colour lookup table
-
-    _lastColor = -1; // Set to illegal value
-
-    // Used to store last shifted colour
-    uint8_t msbColor = 0;
-    uint8_t lsbColor = 0;
-
-    //int32_t spx = x, spy = y;
-
     while (dh--) {
-      int32_t len = dw;
-      uint8_t* ptr = data;
-      uint8_t* linePtr = (uint8_t*)lineBuf;
-
-      int32_t px = x;
-      bool move = true;
-      uint16_t np = 0;
-
-      while (len--) {
-        if (transp != *ptr) {
-          if (move) { move = false; setWindow(px, y, xe, ye);}
-          uint8_t color = *ptr;
-
-          // Shifts are slow so check if colour has changed first
-          if (color != _lastColor) {
-            //          =====Green=====     ===============Red==============
-            msbColor = (color & 0x1C)>>2 | (color & 0xC0)>>3 | (color & 0xE0);
-            //          =====Green=====    =======Blue======
-            lsbColor = (color & 0x1C)<<3 | blue[color & 0x03];
-            _lastColor = color;
-          }
-          *linePtr++ = msbColor;
-          *linePtr++ = lsbColor;
-          np++;
-        }
-        else {
-          move = true;
-          if (np) {
-            pushPixels(lineBuf, np);
-            linePtr = (uint8_t*)lineBuf;
-            np = 0;
-          }
+      int32_t px = 0;
+      while (px < dw) {
+        // Skip transparent pixels, then push the run of pixels that follows in one window
+        while ((px < dw) && (data[px] == transp)) px++;
+        int32_t ps = px;
+        while ((px < dw) && (data[px] != transp)) px++;
+
+        if (px > ps) {
+          setWindow(x + ps, y, xe, ye);
+          convert8bpp(lineBuf, data + ps, px - ps, cmap);
+          pushPixels(lineBuf, px - ps);
         }
-        px++;
-        ptr++;
       }
-
-      if (np) pushPixels(lineBuf, np);
       y++;
       data += w;
     }
@@ -1348,92 +1261,29 @@ void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t *da
   }
   else if (cmap != nullptr) // 4bpp with color map
   {
-    bool swap = _swapBytes; _swapBytes = true;
+    bool swap = _swapBytes; _swapBytes = false; // Line buffer is in bus byte order
+
+    uint16_t pal[16]; // Colour map in bus byte order
+    for (uint32_t i = 0; i < 16; i++) pal[i] = (cmap[i] >> 8) | (cmap[i] << 8);
 
     w = (w+1) & 0xFFFE; // here we try to recreate iwidth from dwidth.
-    bool splitFirst = ((dx & 0x01) != 0);
-    if (splitFirst) {
-      data += ((dx - 1 + dy * w) >> 1);
-    }
-    else {
-      data += ((dx + dy * w) >> 1);
-    }
 
     while (dh--) {
-      uint32_t len = dw;
-      uint8_t * ptr = data;
-
-      int32_t px = x;
-      bool move = true;
-      uint16_t np = 0;
-
-      uint8_t index;  // index into cmap.
-
-      if (splitFirst) {
-        index = (*ptr & 0x0F);  // odd = bits 3 .. 0
-        if (index != transp) {
-          move = false; setWindow(px, y, xe, ye);
-          lineBuf[np] = cmap[index];
-          np++;
-        }
-        px++; ptr++;
-        len--;
-      }
-
-      while (len--)
-      {
-        uint8_t color = *ptr;
-
-        // find the actual color you care about.  There will be two pixels here!
-        // but we may only want one at the end of the row
-        uint16_t index = ((color & 0xF0) >> 4) & 0x0F;  // high bits are the even numbers
-        if (index != transp) {
-          if (move) {
-            move = false; setWindow(px, y, xe, ye);
-          }
-          lineBuf[np] = cmap[index];
-          np++; // added a pixel
-        }
-        else {
-          move = true;
-          if (np) {
-            pushPixels(lineBuf, np);
-            np = 0;
-          }
-        }
-        px++;
-
-        if (len--)
-        {
-          index = color & 0x0F; // the odd number is 3 .. 0
-          if (index != transp) {
-            if (move) {
-              move = false; setWindow(px, y, xe, ye);
-             }
-            lineBuf[np] = cmap[index];
-            np++;
-          }
-          else {
-            move = true;
-            if (np) {
-              pushPixels(lineBuf, np);
-              np = 0;
-            }
-          }
-          px++;
-        }
-        else {
-          break;  // we are done with this row.
+      uint32_t index = dx + dy * w; // Index of first pixel, even pixels are in bits 7..4
+      int32_t  px = 0;
+      while (px < dw) {
+        while ((px < dw) && (((data[(index + px) >> 1] >> ((index + px) & 1 ? 0 : 4)) & 0x0F) == transp)) px++;
+        int32_t ps = px;
+        while ((px < dw) && (((data[(index + px) >> 1] >> ((index + px) & 1 ? 0 : 4)) & 0x0F) != transp)) px++;
+
+        if (px > ps) {
+          setWindow(x + ps, y, xe, ye);
+          convert4bpp(lineBuf, data, index + ps, px - ps, pal);
+          pushPixels(lineBuf, px - ps);
         }
-        ptr++;  // we only increment ptr once in the loop (deliberate)
       }
-
-      if (np) {
-        pushPixels(lineBuf, np);
-        np = 0;
-      }
-      data += (w>>1);
       y++;
+      dy++;
     }
     _swapBytes = swap; // Restore old value
   }
@@ -2024,6 +1874,267 @@ void TFT_eSPI::fillTriangle ( int32_t x0, int32_t y0, int32_t x1, int32_t y1, in
 }
 
 
+#ifndef EXPAND_BITS_SSE2
+// 16 bit lanes of the mask are set for each set bit of a nibble, first pixel in the lowest
+// lane (little endian memory order). MSB first for bitmaps and sprites, LSB first for XBM
+static const uint64_t expandMaskMSB[16] = {
+  0x0000000000000000ULL, 0xFFFF000000000000ULL, 0x0000FFFF00000000ULL, 0xFFFFFFFF00000000ULL,
+  0x00000000FFFF0000ULL, 0xFFFF0000FFFF0000ULL, 0x0000FFFFFFFF0000ULL, 0xFFFFFFFFFFFF0000ULL,
+  0x000000000000FFFFULL, 0xFFFF00000000FFFFULL, 0x0000FFFF0000FFFFULL, 0xFFFFFFFF0000FFFFULL,
+  0x00000000FFFFFFFFULL, 0xFFFF0000FFFFFFFFULL, 0x0000FFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL,
+};
+
+static const uint64_t expandMaskLSB[16] = {
+  0x0000000000000000ULL, 0x000000000000FFFFULL, 0x00000000FFFF0000ULL, 0x00000000FFFFFFFFULL,
+  0x0000FFFF00000000ULL, 0x0000FFFF0000FFFFULL, 0x0000FFFFFFFF0000ULL, 0x0000FFFFFFFFFFFFULL,
+  0xFFFF000000000000ULL, 0xFFFF00000000FFFFULL, 0xFFFF0000FFFF0000ULL, 0xFFFF0000FFFFFFFFULL,
+  0xFFFFFFFF00000000ULL, 0xFFFFFFFF0000FFFFULL, 0xFFFFFFFFFFFF0000ULL, 0xFFFFFFFFFFFFFFFFULL,
+};
+#endif
+
+/***************************************************************************************
+** Function name:           expandBits
+** Description:             Expand 1 bit per pixel data to 16 bit colours
+***************************************************************************************/
+// n bits starting at bit x of src are expanded into dst, a set bit gives fg. Bytes are
+// expanded 4 pixels at a time with 64 bit masks, or 8 pixels at a time with SSE2.
+// src is read with pgm_read_byte() so it can be in FLASH or RAM
+void TFT_eSPI::expandBits(uint16_t *dst, const uint8_t *src, uint32_t x, uint32_t n, uint16_t fg, uint16_t bg, bool lsbFirst)
+{
+  src += x >> 3;
+  x &= 7;
+
+  // Bits before the first whole byte
+  if (x) {
+    uint8_t bits = pgm_read_byte(src++);
+    while ((x < 8) && n) {
+      *dst++ = (bits & (lsbFirst ? (1 << x) : (0x80 >> x))) ? fg : bg;
+      x++; n--;
+    }
+  }
+
+#ifdef EXPAND_BITS_SSE2
+  __m128i vfg  = _mm_set1_epi16(fg);
+  __m128i vbg  = _mm_set1_epi16(bg);
+  __m128i vbit = lsbFirst ? _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128) : _mm_setr_epi16(128, 64, 32, 16, 8, 4, 2, 1);
+
+  while (n >= 8) {
+    __m128i mask = _mm_and_si128(_mm_set1_epi16(pgm_read_byte(src++)), vbit);
+    mask = _mm_cmpeq_epi16(mask, vbit);
+    _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_and_si128(mask, vfg), _mm_andnot_si128(mask, vbg)));
+    dst += 8; n -= 8;
+  }
+#else
+  uint64_t bg4   = bg * 0x0001000100010001ULL;
+  uint64_t diff4 = (fg * 0x0001000100010001ULL) ^ bg4;
+  const uint64_t *maskTable = lsbFirst ? expandMaskLSB : expandMaskMSB;
+
+  while (n >= 8) {
+    uint8_t bits = pgm_read_byte(src++);
+    uint64_t p0, p1;
+    if (lsbFirst) {
+      p0 = bg4 ^ (diff4 & maskTable[bits & 0x0F]);
+      p1 = bg4 ^ (diff4 & maskTable[bits >> 4]);
+    }
+    else {
+      p0 = bg4 ^ (diff4 & maskTable[bits >> 4]);
+      p1 = bg4 ^ (diff4 & maskTable[bits & 0x0F]);
+    }
+    memcpy(dst, &p0, 8);     // dst may not be 8 byte aligned
+    memcpy(dst + 4, &p1, 8);
+    dst += 8; n -= 8;
+  }
+#endif
+
+  // Bits after the last whole byte
+  if (n) {
+    uint8_t bits = pgm_read_byte(src);
+    for (x = 0; x < n; x++) *dst++ = (bits & (lsbFirst ? (1 << x) : (0x80 >> x))) ? fg : bg;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           pushBitmap
+** Description:             Draw a 1 bit per pixel image with background in one window
+***************************************************************************************/
+bool TFT_eSPI::pushBitmap(int32_t x, int32_t y, const uint8_t *bitmap, int32_t w, int32_t h, uint16_t fgcolor, uint16_t bgcolor, bool lsbFirst)
+{
+  if ((x >= _width) || (y >= _height)) return true;
+
+  int32_t byteWidth = (w + 7) / 8;
+
+  int32_t dx = 0;
+  int32_t dy = 0;
+  int32_t dw = w;
+  int32_t dh = h;
+
+  if (x < 0) { dw += x; dx = -x; x = 0; }
+  if (y < 0) { dh += y; dy = -y; y = 0; }
+
+  if ((x + dw) > _width ) dw = _width  - x;
+  if ((y + dh) > _height) dh = _height - y;
+
+  if (dw < 1 || dh < 1) return true;
+
+  begin_tft_write();
+
+  setWindow(x, y, x + dw - 1, y + dh - 1);
+
+  // Line buffer makes plotting faster
+  uint16_t lineBuf[dw];
+
+  bool swap = _swapBytes; _swapBytes = true; // Line buffer holds 565 colours
+
+  bitmap += dy * byteWidth;
+  while (dh--) {
+    expandBits(lineBuf, bitmap, dx, dw, fgcolor, bgcolor, lsbFirst);
+    pushPixels(lineBuf, dw);
+    bitmap += byteWidth;
+  }
+
+  _swapBytes = swap;
+
+  end_tft_write();
+
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           convert8bpp
+** Description:             Convert 8 bit colours to 565 colours in bus byte order
+***************************************************************************************/
+// The pixels are 332 colours converted with the table built by init(), or indexes to a
+// 256 entry pal. The loop is unrolled to convert 4 pixels per pass
+void TFT_eSPI::convert8bpp(uint16_t *dst, const uint8_t *src, uint32_t n, const uint16_t *pal)
+{
+#ifdef NO_COLOR_LUT
+  if (!pal) {
+    while (n--) {
+      uint16_t color = color8to16(*src++);
+      *dst++ = (color >> 8) | (color << 8);
+    }
+    return;
+  }
+#else
+  if (!pal) pal = colorLUT8;
+#endif
+
+  while (n >= 4) {
+    dst[0] = pal[src[0]];
+    dst[1] = pal[src[1]];
+    dst[2] = pal[src[2]];
+    dst[3] = pal[src[3]];
+    dst += 4; src += 4; n -= 4;
+  }
+  while (n--) *dst++ = pal[*src++];
+}
+
+
+/***************************************************************************************
+** Function name:           convert4bpp
+** Description:             Convert 4 bit colours to 565 colours using a colour map
+***************************************************************************************/
+// n pixels starting at pixel x of src are converted, even pixels are in bits 7..4. Two
+// pixels are converted for each byte read, the loop is unrolled to do 4 pixels per pass
+void TFT_eSPI::convert4bpp(uint16_t *dst, const uint8_t *src, uint32_t x, uint32_t n, const uint16_t *pal)
+{
+  src += x >> 1;
+
+  // Odd first pixel is in the low nibble
+  if ((x & 1) && n) {
+    *dst++ = pal[*src++ & 0x0F];
+    n--;
+  }
+
+  while (n >= 4) {
+    uint8_t c0 = src[0];
+    uint8_t c1 = src[1];
+    dst[0] = pal[c0 >> 4];
+    dst[1] = pal[c0 & 0x0F];
+    dst[2] = pal[c1 >> 4];
+    dst[3] = pal[c1 & 0x0F];
+    dst += 4; src += 2; n -= 4;
+  }
+
+  if (n >= 2) {
+    uint8_t c0 = *src++;
+    dst[0] = pal[c0 >> 4];
+    dst[1] = pal[c0 & 0x0F];
+    dst += 2; n -= 2;
+  }
+
+  if (n) *dst = pal[*src >> 4];
+}
+
+
+/***************************************************************************************
+** Function name:           convert2bpp
+** Description:             Convert 2 bit colours to 565 colours using a colour map
+***************************************************************************************/
+// n pixels starting at pixel x of src are converted, the first pixel is in bits 7..6.
+// Four pixels are converted for each byte read
+void TFT_eSPI::convert2bpp(uint16_t *dst, const uint8_t *src, uint32_t x, uint32_t n, const uint16_t *pal)
+{
+  src += x >> 2;
+
+  // Pixels before the first whole byte
+  if (x & 3) {
+    uint8_t c = *src++;
+    for (x &= 3; (x < 4) && n; x++, n--) *dst++ = pal[(c >> ((3 - x) << 1)) & 0x03];
+  }
+
+  while (n >= 4) {
+    uint8_t c = *src++;
+    dst[0] = pal[c >> 6];
+    dst[1] = pal[(c >> 4) & 0x03];
+    dst[2] = pal[(c >> 2) & 0x03];
+    dst[3] = pal[c & 0x03];
+    dst += 4; n -= 4;
+  }
+
+  // Pixels after the last whole byte
+  if (n) {
+    uint8_t c = *src;
+    while (n--) { *dst++ = pal[c >> 6]; c <<= 2; }
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           swapPixels
+** Description:             Byte swap n 16 bit pixels, two at a time, dst can be src
+***************************************************************************************/
+void TFT_eSPI::swapPixels(uint16_t *dst, const uint16_t *src, uint32_t n)
+{
+  // Words are used if both pointers can be 32 bit aligned
+  if ((((uintptr_t)dst ^ (uintptr_t)src) & 2) == 0) {
+    if (((uintptr_t)src & 2) && n) { *dst++ = *src << 8 | *src >> 8; src++; n--; }
+
+    uint32_t *d32 = (uint32_t*)dst;
+    const uint32_t *s32 = (const uint32_t*)src;
+
+    while (n > 3) {
+      uint32_t a = s32[0], b = s32[1];
+      d32[0] = ((a & 0x00FF00FF) << 8) | ((a >> 8) & 0x00FF00FF);
+      d32[1] = ((b & 0x00FF00FF) << 8) | ((b >> 8) & 0x00FF00FF);
+      d32 += 2; s32 += 2; n -= 4;
+    }
+    if (n > 1) {
+      uint32_t a = *s32++;
+      *d32++ = ((a & 0x00FF00FF) << 8) | ((a >> 8) & 0x00FF00FF);
+      n -= 2;
+    }
+
+    dst = (uint16_t*)d32;
+    src = (const uint16_t*)s32;
+  }
+
+  while (n--) { *dst++ = *src << 8 | *src >> 8; src++; }
+}
+
+
 /***************************************************************************************
 ** Function name:           drawBitmap
 ** Description:             Draw an image stored in an array on the TFT
@@ -2035,12 +2146,17 @@ void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w
 
   int32_t i, j, byteWidth = (w + 7) / 8;
 
+  // Runs of set bits are drawn as lines
   for (j = 0; j < h; j++) {
+    int32_t run = 0;
     for (i = 0; i < w; i++ ) {
-      if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (128 >> (i & 7))) {
-        drawPixel(x + i, y + j, color);
+      if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (128 >> (i & 7))) run++;
+      else if (run) {
+        drawFastHLine(x + i - run, y + j, run, color);
+        run = 0;
       }
     }
+    if (run) drawFastHLine(x + w - run, y + j, run, color);
   }
 
   inTransaction = false;
@@ -2054,6 +2170,8 @@ void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w
 ***************************************************************************************/
 void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t fgcolor, uint16_t bgcolor)
 {
+  if (pushBitmap(x, y, bitmap, w, h, fgcolor, bgcolor, false)) return;
+
   //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
   inTransaction = true;
 
@@ -2082,12 +2200,17 @@ void TFT_eSPI::drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t
 
   int32_t i, j, byteWidth = (w + 7) / 8;
 
+  // Runs of set bits are drawn as lines
   for (j = 0; j < h; j++) {
+    int32_t run = 0;
     for (i = 0; i < w; i++ ) {
-      if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (1 << (i & 7))) {
-        drawPixel(x + i, y + j, color);
+      if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (1 << (i & 7))) run++;
+      else if (run) {
+        drawFastHLine(x + i - run, y + j, run, color);
+        run = 0;
       }
     }
+    if (run) drawFastHLine(x + w - run, y + j, run, color);
   }
 
   inTransaction = false;
@@ -2101,6 +2224,8 @@ void TFT_eSPI::drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t
 ***************************************************************************************/
 void TFT_eSPI::drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bgcolor)
 {
+  if (pushBitmap(x, y, bitmap, w, h, color, bgcolor, true)) return;
+
   //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
   inTransaction = true;
 
@@ -2349,6 +2474,13 @@ int16_t TFT_eSPI::textWidth(const char *string, uint8_t font)
 
 #ifdef SMOOTH_FONT
   if(fontLoaded) {
+    const textLayout_t* layout = layoutString(string);
+    if (layout) {
+      isDigits = false;
+      return layout->width;
+    }
+
+    // No RAM for the layout so measure glyph by glyph
     while (*string) {
       uniCode = decodeUTF8(*string++);
       if (uniCode) {
@@ -2370,6 +2502,18 @@ int16_t TFT_eSPI::textWidth(const char *string, uint8_t font)
   }
 #endif
 
+  // Free font widths are cached, numbered and GLCD font widths are quicker to calculate
+  widthCache_t *entry = nullptr;
+#if (TEXT_WIDTH_CACHE > 0) && defined (LOAD_GFXFF)
+  if (gfxFont && (font < 2 || font > 8)) {
+    entry = findTextWidth(string);
+    if (entry && entry->valid) {
+      isDigits = false;
+      return entry->width;
+    }
+  }
+#endif
+
   if (font>1 && font<9) {
     char *widthtable = (char *)pgm_read_dword( &(fontdata[font].widthtbl ) ) - 32; //subtract the 32 outside the loop
 
@@ -2406,10 +2550,172 @@ int16_t TFT_eSPI::textWidth(const char *string, uint8_t font)
     }
   }
   isDigits = false;
+
+  if (entry) {
+    entry->width = str_width * textsize;
+    entry->valid = true;
+  }
+
   return str_width * textsize;
 }
 
 
+/***************************************************************************************
+** Function name:           textWidthNext
+** Description:             Add the next character to a width measured a character at a time
+***************************************************************************************/
+// Widths are found as textWidth() does, the last character measured uses its extent
+// instead of its advance. The caches are not used
+int16_t TFT_eSPI::textWidthNext(const char *string, uint16_t *index, uint16_t len, int32_t *width, uint16_t *last)
+{
+  int32_t extent = 0;
+
+#ifdef SMOOTH_FONT
+  if(fontLoaded) {
+    uint16_t uniCode = decodeUTF8((uint8_t*)string, index, len - *index);
+    uint16_t gNum = 0;
+
+    if (uniCode == 0x20) { *width += gFont.spaceWidth; *last = 0; return *width; }
+
+    if (!getUnicodeIndex(uniCode, &gNum)) { *width += gFont.spaceWidth + 1; *last = 0; return *width; }
+
+    if (*last) *width += getKerning(*last, uniCode);
+    if (*width == 0 && gdX[gNum] < 0) *width -= gdX[gNum];
+    extent = *width + gdX[gNum] + gWidth[gNum];
+    *width += gxAdvance[gNum];
+    *last = uniCode;
+
+    return extent;
+  }
+#endif
+
+  if (textfont>1 && textfont<9) {
+    char *widthtable = (char *)pgm_read_dword( &(fontdata[textfont].widthtbl ) ) - 32;
+    uint16_t uniCode = (uint8_t)string[(*index)++];
+    if (uniCode > 31 && uniCode < 128) *width += pgm_read_byte( widthtable + uniCode);
+    else *width += pgm_read_byte( widthtable + 32); // Illegal character = space width
+    extent = *width;
+  }
+  else {
+#ifdef LOAD_GFXFF
+    if(gfxFont) {
+      uint16_t uniCode = decodeUTF8((uint8_t*)string, index, len - *index);
+      extent = *width;
+      if ((uniCode >= pgm_read_word(&gfxFont->first)) && (uniCode <= pgm_read_word(&gfxFont->last ))) {
+        uniCode -= pgm_read_word(&gfxFont->first);
+        GFXglyph *glyph  = &(((GFXglyph *)pgm_read_dword(&gfxFont->glyph))[uniCode]);
+        extent += ((int8_t)pgm_read_byte(&glyph->xOffset) + pgm_read_byte(&glyph->width));
+        *width += pgm_read_byte(&glyph->xAdvance);
+      }
+    }
+    else
+#endif
+    {
+      (*index)++;
+#ifdef LOAD_GLCD
+      *width += 6;
+#endif
+      extent = *width;
+    }
+  }
+
+  return extent * textsize;
+}
+
+
+/***************************************************************************************
+** Function name:           findTextWidth
+** Description:             Find a string in the width cache, else return entry to fill
+***************************************************************************************/
+// Returns nullptr if the string is too long to keep, there is no RAM or all entries are
+// kept by cacheTextWidth()
+widthCache_t* TFT_eSPI::findTextWidth(const char *string)
+{
+  uint32_t hash = 2166136261UL;
+  uint16_t len  = 0;
+  while (string[len]) {
+    if (len >= TEXT_WIDTH_CACHE_LEN) return nullptr;
+    hash = (hash ^ (uint8_t)string[len++]) * 16777619UL;
+  }
+
+  if (!_widthCache) {
+    _widthCache = (widthCache_t*)calloc(TEXT_WIDTH_CACHE, sizeof(widthCache_t));
+    if (!_widthCache) return nullptr;
+  }
+
+  const void *gfx = nullptr;
+#ifdef LOAD_GFXFF
+  gfx = gfxFont;
+#endif
+
+  _widthTick++;
+
+  widthCache_t *slot = nullptr;
+
+  for (uint16_t i = 0; i < TEXT_WIDTH_CACHE; i++) {
+    widthCache_t *entry = _widthCache + i;
+    if (entry->valid && (entry->hash == hash) && (entry->len == len) && (entry->gfx == gfx) &&
+        (entry->size == textsize) && (entry->digits == isDigits) && !memcmp(entry->text, string, len)) {
+      entry->used = _widthTick;
+      if (_pinWidth) entry->pinned = true;
+      return entry;
+    }
+    if (!entry->pinned && (!slot || (entry->used < slot->used))) slot = entry;
+  }
+
+  if (slot) {
+    slot->hash   = hash;
+    slot->gfx    = gfx;
+    slot->used   = _widthTick;
+    slot->len    = len;
+    memcpy(slot->text, string, len + 1);
+    slot->size   = textsize;
+    slot->digits = isDigits;
+    slot->valid  = false;
+    slot->pinned = _pinWidth;
+  }
+
+  return slot;
+}
+
+
+/***************************************************************************************
+** Function name:           cacheTextWidth
+** Description:             Measure a string and keep the width in the cache
+***************************************************************************************/
+int16_t TFT_eSPI::cacheTextWidth(const char *string)
+{
+  return cacheTextWidth(string, textfont);
+}
+
+int16_t TFT_eSPI::cacheTextWidth(const char *string, uint8_t font)
+{
+  _pinWidth = true;
+  int16_t width = textWidth(string, font);
+  _pinWidth = false;
+  return width;
+}
+
+
+/***************************************************************************************
+** Function name:           clearTextWidthCache
+** Description:             Free the width cache, strings kept by cacheTextWidth() are released
+***************************************************************************************/
+void TFT_eSPI::clearTextWidthCache(void)
+{
+  if (_widthCache) {
+    free(_widthCache);
+    _widthCache = nullptr;
+  }
+
+#ifdef SMOOTH_FONT
+  if (gLayout) {
+    for (uint16_t i = 0; i < LAYOUT_CACHE_ENTRIES; i++) gLayout[i].pinned = false;
+  }
+#endif
+}
+
+
 /***************************************************************************************
 ** Function name:           fontsLoaded
 ** Description:             return an encoded 16 bit value showing the fonts loaded
@@ -2470,24 +2776,29 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32
   bool fillbg = (bg != color);
 
   if ((size==1) && fillbg) {
-    uint8_t column[6];
+    uint8_t column[5];
     uint8_t mask = 0x1;
+    uint16_t charBuf[6 * 8];
     begin_tft_write();
 
     setWindow(x, y, x+5, y+8);
 
     for (int8_t i = 0; i < 5; i++ ) column[i] = pgm_read_byte(font + (c * 5) + i);
-    column[5] = 0;
 
+    // Font columns are turned into rows of bits, the 6th pixel is the gap
     for (int8_t j = 0; j < 8; j++) {
+      uint8_t line = 0;
       for (int8_t k = 0; k < 5; k++ ) {
-        if (column[k] & mask) {tft_Write_16(color);}
-        else {tft_Write_16(bg);}
+        if (column[k] & mask) line |= 0x80 >> k;
       }
       mask <<= 1;
-      tft_Write_16(bg);
+      expandBits(charBuf + j * 6, &line, 0, 6, color, bg, false);
     }
 
+    bool swap = _swapBytes; _swapBytes = true; // Buffer holds 565 colours
+    pushPixels(charBuf, 6 * 8);
+    _swapBytes = swap;
+
     end_tft_write();
   }
   else {
@@ -2614,6 +2925,8 @@ void TFT_eSPI::setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
 {
   //begin_tft_write(); // Must be called before setWindow
 
+  STATS_ADD(windows, 1);
+
   addr_col = 0xFFFF;
   addr_row = 0xFFFF;
 
@@ -2694,12 +3007,16 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
 
   begin_tft_write();
 
+  STATS_ADD(drawPixels, 1);
+  STATS_ADD(pixels, 1);
+
   // No need to send x if it has not changed (speeds things up)
   if (addr_col != x) {
     DC_C; tft_Write_8(TFT_CASET);
     DC_D; tft_Write_32D(x);
     addr_col = x;
   }
+  else { STATS_ADD(casetSkips, 1); }
 
   // No need to send y if it has not changed (speeds things up)
   if (addr_row != y) {
@@ -2707,6 +3024,7 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
     DC_D; tft_Write_32D(y);
     addr_row = y;
   }
+  else { STATS_ADD(pasetSkips, 1); }
 
   DC_C; tft_Write_8(TFT_RAMWR);
   DC_D; tft_Write_16(color);
@@ -2714,6 +3032,105 @@ void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
   end_tft_write();
 }
 
+/***************************************************************************************
+** Function name:           drawPixels
+** Description:             draw a batch of pixels, merging them into horizontal runs
+***************************************************************************************/
+// Sort keys hold y:x:index so rows are in ascending x order and a repeated location
+// sorts in batch order, the last colour is then drawn as it would be by drawPixel()
+static int pixelKeyCompare(const void *a, const void *b)
+{
+  uint64_t ka = *(const uint64_t*)a;
+  uint64_t kb = *(const uint64_t*)b;
+  return (ka > kb) - (ka < kb);
+}
+
+uint32_t TFT_eSPI::drawPixels(const tftPoint_t *points, const uint16_t *colors, uint32_t n)
+{
+  if (!n) return 0;
+
+  uint64_t *key = (uint64_t*)malloc(n * sizeof(uint64_t));
+
+  // Not enough RAM to sort so draw one at a time
+  if (!key) {
+    for (uint32_t i = 0; i < n; i++) drawPixel(points[i].x, points[i].y, colors[i]);
+    return 0;
+  }
+
+  // Range checking
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    int32_t x = points[i].x;
+    int32_t y = points[i].y;
+    if ((x < 0) || (y < 0) ||(x >= _width) || (y >= _height)) continue;
+    key[count++] = ((uint64_t)((y << 16) | x) << 32) | i;
+  }
+
+  qsort(key, count, sizeof(uint64_t), pixelKeyCompare);
+
+  begin_tft_write();
+  inTransaction = true;
+
+  uint32_t runs = 0;
+  uint32_t i = 0;
+  while (i < count) {
+    uint32_t pos = key[i] >> 32;
+
+    // Find the end of the run, repeated locations do not extend it
+    uint32_t j = i;
+    uint32_t end = pos;
+    while ((j + 1 < count) && (((key[j + 1] >> 32) == end) || ((key[j + 1] >> 32) == end + 1))) {
+      end = key[++j] >> 32;
+    }
+
+    int32_t x0 = pos & 0xFFFF;
+    int32_t x1 = end & 0xFFFF;
+    int32_t y  = pos >> 16;
+
+#ifdef CGRAM_OFFSET
+    x0+=colstart;
+    x1+=colstart;
+    y+=rowstart;
+#endif
+
+    STATS_ADD(windows, 1);
+    STATS_ADD(pixels, x1 - x0 + 1);
+
+    // Column addr set, always needed as the run length changes
+    DC_C; tft_Write_8(TFT_CASET);
+    DC_D; tft_Write_32C(x0, x1);
+
+    // No need to send y if it has not changed (the previous run was on the same row)
+    if (addr_row != y) {
+      DC_C; tft_Write_8(TFT_PASET);
+      DC_D; tft_Write_32D(y);
+      addr_row = y;
+    }
+    else { STATS_ADD(pasetSkips, 1); }
+
+    DC_C; tft_Write_8(TFT_RAMWR);
+    DC_D;
+
+    // Write the last colour given for each location in the run
+    for (; i <= j; i++) {
+      if ((i < j) && ((key[i] >> 32) == (key[i + 1] >> 32))) continue;
+      tft_Write_16(colors[(uint32_t)key[i]]);
+    }
+
+    runs++;
+  }
+
+  // Column window is no longer a single pixel so drawPixel() must set it
+  addr_col = 0xFFFF;
+
+  inTransaction = false;
+  end_tft_write();
+
+  free(key);
+
+  return count - runs;
+}
+
 /***************************************************************************************
 ** Function name:           pushColor
 ** Description:             push a single pixel
@@ -3417,7 +3834,7 @@ int16_t TFT_eSPI::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font)
 
   int32_t width  = 0;
   int32_t height = 0;
-  uint32_t flash_address = 0;
+  uintptr_t flash_address = 0; // Pointer sized so fonts can be used on 64 bit hosts
   uniCode -= 32;
 
 #ifdef LOAD_FONT2
@@ -3452,7 +3869,10 @@ int16_t TFT_eSPI::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font)
     w = w / 8;
     if (x + width * textsize >= (int16_t)_width) return width * textsize ;
 
-    if (textcolor == textbgcolor || textsize != 1) {
+    // The block write below is not clipped, so partly off screen characters are drawn a line at a time
+    bool clip = (x < 0) || (y < 0) || (y + height * textsize > _height);
+
+    if (textcolor == textbgcolor || textsize != 1 || clip) {
       //begin_tft_write();          // Sprite class can use this function, avoiding begin_tft_write()
       inTransaction = true;
 
@@ -3528,52 +3948,55 @@ int16_t TFT_eSPI::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font)
     begin_tft_write();
     inTransaction = true;
 
-    w *= height; // Now w is total number of pixels in the character
-    if ((textsize != 1) || (textcolor == textbgcolor)) {
-      if (textcolor != textbgcolor) fillRect(x, pY, width * textsize, textsize * height, textbgcolor);
-      int32_t px = 0, py = pY; // To hold character block start and end column and row values
-      int32_t pc = 0; // Pixel count
-      uint8_t np = textsize * textsize; // Number of pixels in a drawn pixel
-
-      uint8_t tnp = 0; // Temporary copy of np for while loop
-      uint8_t ts = textsize - 1; // Temporary copy of textsize
-      // 16 bit pixel count so maximum font size is equivalent to 180x180 pixels in area
-      // w is total number of pixels to plot to fill character block
-      while (pc < w) {
-        line = pgm_read_byte((uint8_t *)flash_address);
-        flash_address++;
-        if (line & 0x80) {
-          line &= 0x7F;
-          line++;
-          if (ts) {
-            px = x + textsize * (pc % width); // Keep these px and py calculations outside the loop as they are slow
-            py = y + textsize * (pc / width);
-          }
-          else {
-            px = x + pc % width; // Keep these px and py calculations outside the loop as they are slow
-            py = y + pc / width;
-          }
-          while (line--) { // In this case the while(line--) is faster
-            pc++; // This is faster than putting pc+=line before while()?
-            setWindow(px, py, px + ts, py + ts);
+    // Runs of a glyph that is partly off screen are drawn with fillRect() so they are clipped
+    bool clip = (x < 0) || (y < 0) || (x + width * textsize > _width) || (y + height * textsize > _height);
+
+    if ((textsize != 1) || (textcolor == textbgcolor) || clip) {
+      // Each glyph line is decoded into runs that are sent with pushBlock(). RLE runs
+      // can continue onto the next line, so the part left at the end of a line is kept
+      bool    fill = (textcolor != textbgcolor);
+      uint8_t ts   = textsize;
+      uint8_t run  = 0;     // Pixels left in the current run
+      bool    ink  = false; // Current run is foreground
+
+      // With a background the whole scaled glyph is one window, each line is decoded
+      // again for each of the textsize rows it is scaled to
+      if (fill && !clip) setWindow(x, y, x + width * ts - 1, y + height * ts - 1);
 
-            if (ts) {
-              tnp = np;
-              while (tnp--) {tft_Write_16(textcolor);}
+      for (int32_t i = 0; i < height; i++) {
+        uintptr_t lineAddr = flash_address; // Decoder state at start of line
+        uint8_t   lineRun  = run;
+        bool      lineInk  = ink;
+
+        uint8_t rows = (fill && !clip) ? ts : 1;
+        while (rows--) {
+          flash_address = lineAddr;
+          run = lineRun;
+          ink = lineInk;
+
+          pX = 0;
+          while (pX < width) {
+            if (!run) {
+              line = pgm_read_byte((uint8_t *)flash_address++);
+              ink  = line & 0x80;
+              run  = (line & 0x7F) + 1;
             }
-            else {tft_Write_16(textcolor);}
-            px += textsize;
+            int32_t np = run;
+            if (np > width - pX) np = width - pX;
 
-            if (px >= (x + width * textsize)) {
-              px = x;
-              py += textsize;
+            if (clip) {
+              if (fill || ink) fillRect(x + pX * ts, pY, np * ts, ts, ink ? textcolor : textbgcolor);
+            }
+            else if (fill) pushBlock(ink ? textcolor : textbgcolor, np * ts);
+            else if (ink) { // Transparent background so only foreground runs are drawn
+              setWindow(x + pX * ts, pY, x + (pX + np) * ts - 1, pY + ts - 1);
+              pushBlock(textcolor, np * ts * ts);
             }
+            pX  += np;
+            run -= np;
           }
         }
-        else {
-          line++;
-          pc += line;
-        }
+        pY += ts;
       }
     }
     else { // Text colour != background && textsize = 1
@@ -3581,6 +4004,7 @@ int16_t TFT_eSPI::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font)
       setWindow(x, y, x + width - 1, y + height - 1);
 
       // Maximum font size is equivalent to 180x180 pixels in area
+      w *= height; // Now w is total number of pixels in the character
       while (w > 0) {
         line = pgm_read_byte((uint8_t *)flash_address++); // 8 bytes smaller when incrementing here
         if (line & 0x80) {
@@ -3635,7 +4059,19 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
 {
   int16_t sumX = 0;
   uint8_t padding = 1, baseline = 0;
-  uint16_t cwidth = textWidth(string, font); // Find the pixel width of the string in the font
+  uint16_t cwidth;
+
+#ifdef SMOOTH_FONT
+  // Smooth font strings are shaped once, the run gives the width and is then drawn
+  const textLayout_t* layout = nullptr;
+  if (fontLoaded) layout = layoutString(string);
+  if (layout) {
+    cwidth = layout->width;
+    isDigits = false;
+  }
+  else
+#endif
+  cwidth = textWidth(string, font); // Find the pixel width of the string in the font
   uint16_t cheight = 8 * textsize;
 
 #ifdef LOAD_GFXFF
@@ -3735,6 +4171,7 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
 
 
   int8_t xo = 0;
+  bool drawn = false; // Set if string and background are drawn as one block
 #ifdef LOAD_GFXFF
   if (freeFont && (textcolor!=textbgcolor)) {
       cheight = (glyph_ab + glyph_bb) * textsize;
@@ -3755,7 +4192,8 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
         // Add 1 pixel of padding all round
         //cheight +=2;
         //fillRect(poX+xo-1, poY - 1 - glyph_ab * textsize, cwidth+2, cheight, textbgcolor);
-        fillRect(poX+xo, poY - glyph_ab * textsize, cwidth, cheight, textbgcolor);
+        drawn = drawStringGFX(string, poX, poY, poX+xo, cwidth, &sumX);
+        if (!drawn) fillRect(poX+xo, poY - glyph_ab * textsize, cwidth, cheight, textbgcolor);
       }
       padding -=100;
     }
@@ -3770,16 +4208,24 @@ int16_t TFT_eSPI::drawString(const char *string, int32_t poX, int32_t poY, uint8
 
     setCursor(poX, poY);
 
-    while (n < len) {
-      uint16_t uniCode = decodeUTF8((uint8_t*)string, &n, len - n);
-      drawGlyph(uniCode);
+    if (layout) {
+      for (uint16_t i = 0; i < layout->count; i++) {
+        cursor_x += layout->glyph[i].kern;
+        drawGlyph(layout->glyph[i].code);
+      }
+    }
+    else {
+      while (n < len) {
+        uint16_t uniCode = decodeUTF8((uint8_t*)string, &n, len - n);
+        drawGlyph(uniCode);
+      }
     }
     sumX += cwidth;
     //fontFile.close();
   }
   else
 #endif
-  {
+  if (!drawn) {
     while (n < len) {
       uint16_t uniCode = decodeUTF8((uint8_t*)string, &n, len - n);
       sumX += drawChar(uniCode, poX+sumX, poY, font);
@@ -3855,6 +4301,114 @@ return sumX;
 }
 
 
+/***************************************************************************************
+** Function name:           drawStringGFX
+** Description:             draw a GFX free font string and background as one block
+***************************************************************************************/
+// The block is bx to bx+bw-1 wide and spans the font height about the baseline y.
+// Each line of the block is rendered into a line buffer and sent with pushPixels(),
+// so all the text and background is sent in one window and transaction.
+bool TFT_eSPI::drawStringGFX(const char *string, int32_t x, int32_t y, int32_t bx, int32_t bw, int16_t *advance)
+{
+#ifdef LOAD_GFXFF
+  uint16_t  first  = pgm_read_word(&gfxFont->first);
+  uint16_t  last   = pgm_read_word(&gfxFont->last);
+  GFXglyph *glyphs = (GFXglyph *)pgm_read_dword(&gfxFont->glyph);
+  uint8_t  *bitmap = (uint8_t *)pgm_read_dword(&gfxFont->bitmap);
+  uint16_t  len    = strlen(string);
+  uint16_t  n      = 0;
+
+  // Same advance as drawChar() returns for each character
+  int16_t sumX = 0;
+  while (n < len) {
+    uint16_t c = decodeUTF8((uint8_t*)string, &n, len - n);
+    if (c && (c >= first) && (c <= last)) sumX += pgm_read_byte(&glyphs[c - first].xAdvance) * textsize;
+  }
+  *advance += sumX;
+
+  // Clip the block to the screen
+  int32_t by = y - glyph_ab * textsize;
+  int32_t bh = (glyph_ab + glyph_bb) * textsize;
+  int32_t cx = bx, cy = by;
+  if (cx < 0) { bw += cx; cx = 0; }
+  if (cy < 0) { bh += cy; cy = 0; }
+  if (cx + bw > _width)  bw = _width  - cx;
+  if (cy + bh > _height) bh = _height - cy;
+  if ((bw < 1) || (bh < 1)) return true;
+
+  uint16_t lineBuf[bw];
+
+  begin_tft_write();
+
+  setWindow(cx, cy, cx + bw - 1, cy + bh - 1);
+
+  bool swap = _swapBytes; _swapBytes = true; // Line buffer holds 565 colours
+
+  int32_t row = 0x7FFFFFFF; // Font row in line buffer, relative to baseline
+  for (int32_t py = cy; py < cy + bh; py++) {
+    int32_t r = (py - by) / textsize - glyph_ab;
+
+    // Scaled text repeats each font row textsize times
+    if (r != row) {
+      row = r;
+      for (int32_t i = 0; i < bw; i++) lineBuf[i] = textbgcolor;
+
+      int32_t gx = x; // Glyph origin
+      n = 0;
+      while (n < len) {
+        uint16_t c = decodeUTF8((uint8_t*)string, &n, len - n);
+        if (!c || (c < first) || (c > last)) continue;
+
+        GFXglyph *glyph = &glyphs[c - first];
+        uint8_t w  = pgm_read_byte(&glyph->width),
+                h  = pgm_read_byte(&glyph->height);
+        int8_t  xo = pgm_read_byte(&glyph->xOffset),
+                yo = pgm_read_byte(&glyph->yOffset);
+        int32_t gy = r - yo; // Row within glyph bitmap
+
+        // Same character clipping as drawChar()
+        bool clip = (gx >= _width) || (y >= _height) || ((gx + 6 * textsize - 1) < 0) || ((y + 8 * textsize - 1) < 0);
+
+        if ((c >= 32) && !clip && (gy >= 0) && (gy < h)) {
+          // Glyph bitmap rows are not byte aligned
+          uint32_t bit  = gy * w;
+          uint32_t bo   = pgm_read_word(&glyph->bitmapOffset) + (bit >> 3);
+          uint8_t  mask = 0x80 >> (bit & 7);
+          uint8_t  bits = pgm_read_byte(&bitmap[bo++]);
+          int32_t  px   = gx + xo * textsize - cx;
+
+          for (uint8_t xx = 0; xx < w; xx++) {
+            if (!mask) {
+              bits = pgm_read_byte(&bitmap[bo++]);
+              mask = 0x80;
+            }
+            if (bits & mask) {
+              for (uint8_t s = 0; s < textsize; s++) {
+                if (((px + s) >= 0) && ((px + s) < bw)) lineBuf[px + s] = textcolor;
+              }
+            }
+            mask >>= 1;
+            px += textsize;
+          }
+        }
+        gx += pgm_read_byte(&glyph->xAdvance) * textsize;
+      }
+    }
+
+    pushPixels(lineBuf, bw);
+  }
+
+  _swapBytes = swap;
+
+  end_tft_write();
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+
 /***************************************************************************************
 ** Function name:           drawCentreString (deprecated, use setTextDatum())
 ** Descriptions:            draw string centred on dX
@@ -4075,6 +4629,27 @@ SPIClass& TFT_eSPI::getSPIinstance(void)
 }
 #endif
 
+#ifdef TFT_eSPI_STATS
+/***************************************************************************************
+** Function name:           getStats
+** Description:             Take a snapshot of the bus activity counters
+***************************************************************************************/
+void TFT_eSPI::getStats(tftStats_t &tft_stats)
+{
+  tft_stats = _stats;
+}
+
+/***************************************************************************************
+** Function name:           resetStats
+** Description:             Set the bus activity counters to zero
+***************************************************************************************/
+void TFT_eSPI::resetStats(void)
+{
+  memset(&_stats, 0, sizeof(_stats));
+  if (_statsBusy) _statsStart = micros(); // Only time the rest of an open transaction
+}
+#endif
+
 /***************************************************************************************
 ** Function name:           getSetup
 ** Description:             Get the setup details for diagnostic and sketch access
@@ -4222,6 +4797,12 @@ void TFT_eSPI::getSetup(setup_t &tft_settings)
 
 #include "Extensions/Sprite.cpp"
 
+#include "Extensions/TextBox.cpp"
+
+#include "Extensions/NumberField.cpp"
+
+#include "Extensions/BandRenderer.cpp"
+
 #ifdef SMOOTH_FONT
   #include "Extensions/Smooth_font.cpp"
 #endif
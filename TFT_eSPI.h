@@ -25,7 +25,9 @@
 //Standard support
 #include <Arduino.h>
 #include <Print.h>
-#include <SPI.h>
+#if !defined (TFT_HOST) // Host builds use a bus model in place of the SPI library
+  #include <SPI.h>
+#endif
 
 /***************************************************************************************
 **                         Section 2: Load library and processor specific header files
@@ -50,6 +52,8 @@
   #include "Processors/TFT_eSPI_ESP8266.h"
 #elif defined (STM32)
   #include "Processors/TFT_eSPI_STM32.h"
+#elif defined (TFT_HOST)
+  #include "Processors/TFT_eSPI_Host.h"
 #else
   #include "Processors/TFT_eSPI_Generic.h"
 #endif
@@ -83,6 +87,13 @@
   #define SPI_TOUCH_FREQUENCY  2500000
 #endif
 
+// 8 bit colours are converted to 565 with a 256 entry table (512 bytes) built by init().
+// The table can be placed with COLOR_LUT_ATTR (e.g. DRAM_ATTR on ESP32, IRAM cannot be used
+// as it only allows 32 bit reads), or define NO_COLOR_LUT to save the RAM
+#ifndef COLOR_LUT_ATTR
+  #define COLOR_LUT_ATTR
+#endif
+
 /***************************************************************************************
 **                         Section 4: Setup fonts
 ***************************************************************************************/
@@ -92,6 +103,34 @@
   #ifndef LOAD_GLCD
     #define LOAD_GLCD
   #endif
+
+  // RAM budget in bytes for the glyph bitmap cache used with smooth font files,
+  // 0 disables the cache. Can be changed at run time with setGlyphCacheSize()
+  #ifndef GLYPH_CACHE_SIZE
+    #define GLYPH_CACHE_SIZE 4096
+  #endif
+
+  // Maximum number of glyphs held in the cache
+  #ifndef GLYPH_CACHE_ENTRIES
+    #define GLYPH_CACHE_ENTRIES 64
+  #endif
+
+  // Number of shaped text strings held for reuse by drawString() and textWidth()
+  #ifndef LAYOUT_CACHE_ENTRIES
+    #define LAYOUT_CACHE_ENTRIES 4
+  #endif
+#endif
+
+// Number of string widths held for reuse by drawString() and textWidth() when using the
+// free fonts (smooth fonts use the layout cache), 0 disables the cache. Numbered font
+// widths are quicker to add up than to look up
+#ifndef TEXT_WIDTH_CACHE
+  #define TEXT_WIDTH_CACHE 8
+#endif
+
+// Longest string held in the width cache, longer strings are measured each time
+#ifndef TEXT_WIDTH_CACHE_LEN
+  #define TEXT_WIDTH_CACHE_LEN 31
 #endif
 
 // Only load the fonts defined in User_Setup.h (to save space)
@@ -284,6 +323,7 @@ static const uint16_t default_4bit_palette[] PROGMEM = {
 ***************************************************************************************/
 // #define TFT_eSPI_DEBUG     // Switch on debug support serial messages  (not used yet)
 // #define TFT_eSPI_FNx_DEBUG // Switch on debug support for function "x" (not used yet)
+// #define TFT_eSPI_STATS     // Switch on bus activity counters, see getStats()
 
 // This structure allows sketches to retrieve the user setup parameters at runtime
 // by calling getSetup(), zero impact on code size unless used, mainly for diagnostics
@@ -342,6 +382,29 @@ int16_t tft_rd_freq; // TFT read  SPI frequency
 int16_t tch_spi_freq;// Touch controller read/write SPI frequency
 } setup_t;
 
+// If TFT_eSPI_STATS is defined the hot path functions count the bus activity they
+// generate, getStats() returns a snapshot. If not defined the macros generate no code
+#ifdef TFT_eSPI_STATS
+typedef struct
+{
+uint32_t transactions; // Write transactions started (TFT chip select set low)
+uint32_t writeTime;    // Time spent in write transactions in microseconds
+uint32_t windows;      // Address windows set by setWindow() and drawPixels()
+uint32_t drawPixels;   // Calls to drawPixel()
+uint32_t casetSkips;   // drawPixel() column address commands not sent as addr_col unchanged
+uint32_t pasetSkips;   // drawPixel(s)() row address commands not sent as addr_row unchanged
+uint32_t pixels;       // Pixels written by drawPixel(s)(), pushBlock() and pushPixels()
+} tftStats_t;
+
+  #define STATS_ADD(N, V)   do { _stats.N += (V); } while (0)
+  #define STATS_WRITE_BEGIN do { if (!_statsBusy) { _statsBusy = true; _stats.transactions++; _statsStart = micros(); } } while (0)
+  #define STATS_WRITE_END   do { if (_statsBusy && !inTransaction) { _statsBusy = false; _stats.writeTime += micros() - _statsStart; } } while (0)
+#else
+  #define STATS_ADD(N, V)   do { } while (0)
+  #define STATS_WRITE_BEGIN do { } while (0)
+  #define STATS_WRITE_END   do { } while (0)
+#endif
+
 /***************************************************************************************
 **                         Section 8: Class member and support functions
 ***************************************************************************************/
@@ -352,6 +415,40 @@ swap_coord(T& a, T& b) { T t = a; a = b; b = t; }
 // Callback prototype for smooth font pixel colour read
 typedef uint16_t (*getColorCallback)(uint16_t x, uint16_t y);
 
+// Callback prototype for queued DMA block completion, called from the DMA interrupt
+typedef void (*dmaCallback)(void *arg);
+
+// Pixel coordinate used by drawPixels()
+typedef struct
+{
+int16_t x;
+int16_t y;
+} tftPoint_t;
+
+// Rectangle with inclusive start and end coordinates, used for Sprite change tracking
+typedef struct
+{
+int16_t xs;
+int16_t ys;
+int16_t xe;
+int16_t ye;
+} tftRect_t;
+
+// Measured string width, the hash and length are compared before the string
+typedef struct
+{
+uint32_t hash;      // FNV-1a hash of the string
+const void *gfx;    // Free font selected when measured
+uint32_t used;      // Count of look ups when last used, oldest is replaced first
+uint16_t len;       // String length
+int16_t  width;     // Width in pixels
+char     text[TEXT_WIDTH_CACHE_LEN + 1]; // Copy of the string
+uint8_t  size;      // Text size
+bool     digits;    // isDigits was set when measured
+bool     valid;     // Width has been measured
+bool     pinned;    // Kept by cacheTextWidth(), not replaced
+} widthCache_t;
+
 // Class functions and variables
 class TFT_eSPI : public Print {
 
@@ -377,6 +474,10 @@ class TFT_eSPI : public Print {
                    height(void),
                    width(void);
 
+  // Draw a batch of n pixels, adjacent pixels in a row are merged into runs sharing one
+  // address window. Returns the number of address windows saved compared to drawPixel()
+  virtual uint32_t drawPixels(const tftPoint_t *points, const uint16_t *colors, uint32_t n);
+
   void     setRotation(uint8_t r); // Set the display image orientation to 0, 1, 2 or 3
   uint8_t  getRotation(void);      // Read the current rotation
 
@@ -463,7 +564,8 @@ class TFT_eSPI : public Print {
 
            // These are used by Sprite class pushSprite() member function for 1, 4 and 8 bits per pixel (bpp) colours
            // They are not intended to be used with user sketches (but could be)
-           // Set bpp8 true for 8bpp sprites, false otherwise. The cmap pointer must be specified for 4bpp
+           // Set bpp8 true for 8bpp sprites, false otherwise. The cmap pointer must be specified for 4bpp,
+           // if specified for 8bpp the pixels are indexes to a 256 entry cmap instead of 332 colours
   void     pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t  *data, bool bpp8 = true, uint16_t *cmap = nullptr);
   void     pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t  *data, uint8_t  transparent, bool bpp8 = true, uint16_t *cmap = nullptr);
 
@@ -527,6 +629,19 @@ class TFT_eSPI : public Print {
            fontHeight(int16_t font),                        // Returns pixel height of string in specified font
            fontHeight(void);                                // Returns pixel width of string in current font
 
+           // Measure a string and keep the width so drawString() and textWidth() do not measure
+           // it again, e.g. for static labels drawn every frame. Returns the pixel width
+  int16_t  cacheTextWidth(const char *string, uint8_t font),
+           cacheTextWidth(const char *string);
+  void     clearTextWidthCache(void);                       // Free the cache, including kept strings
+
+           // Measure text in the current font one character at a time, e.g. to find where a
+           // line must wrap. Reads the character at string[*index] (len is the end of the text)
+           // and returns the width of the text up to and including it. width and last carry
+           // the measurement to the next call and are set to 0 for the first character.
+           // Ligatures are not substituted, so a ligature may make the text a little narrower
+  int16_t  textWidthNext(const char *string, uint16_t *index, uint16_t len, int32_t *width, uint16_t *last);
+
            // Used by library and Smooth font class to extract Unicode point codes from a UTF8 encoded string
   uint16_t decodeUTF8(uint8_t *buf, uint16_t *index, uint16_t remaining),
            decodeUTF8(uint8_t c);
@@ -609,18 +724,42 @@ class TFT_eSPI : public Print {
            // in the original data image will be swapped by the function before DMA is initiated.
            // The function will wait for the last DMA to complete if it is called while a previous DMA is still
            // in progress, this simplifies the sketch and helps avoid "gotchas".
-  void     pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer = nullptr);
+           // Set wireOrder true if the data is already in TFT byte order (e.g. a 16 bit Sprite, see
+           // getWireOrder()), it is then never swapped whatever the setSwapBytes() setting
+  void     pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, uint16_t* buffer = nullptr, bool wireOrder = false);
 
            // Push a block of pixels into a window set up using setAddrWindow()
-  void     pushPixelsDMA(uint16_t* image, uint32_t len);
+           // On ESP32 the pixels are never swapped, elsewhere they are swapped in place as for pushImageDMA()
+  void     pushPixelsDMA(uint16_t* image, uint32_t len, bool wireOrder = false);
+
+           // Byte swap 16 bit colours to or from TFT byte order, dst and src can be the same buffer
+  void     swapPixels(uint16_t *dst, const uint16_t *src, uint32_t n);
 
            // Check if the DMA is complete - use while(tft.dmaBusy); for a blocking wait
-           // Note: for ESP32 the dmaBusy() function is blocking at the moment - to be updated
   bool     dmaBusy(void);
   void     dmaWait(void);
 
+           // STM32 only: returns true if a DMA transfer failed since the last call, the rest of
+           // the pixels in that transfer are not sent
+  bool     dmaError(void);
+
+           // ESP32 only: queue an image to a window without waiting for earlier DMA transfers, so
+           // the next image can be prepared while the bus is busy. Up to DMA_QUEUE_BLOCKS images
+           // can be queued. The pixels are not copied or byte swapped, so must be in bus byte order
+           // (e.g. a 16 bit Sprite) and must not change until the block is complete. Rows off the
+           // screen are clipped, but the image width must fit on the screen.
+           // Returns a fence value for the block, or 0 if it was not queued (queue full or not on
+           // screen). The optional callback is called from the DMA interrupt when the block is
+           // complete, so it must be short and placed in IRAM (IRAM_ATTR)
+  uint32_t queueImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data, dmaCallback callback = nullptr, void* arg = nullptr);
+
+           // Count of queued blocks completed, a block is complete when the count reaches its fence
+  uint32_t dmaFence(void);
+           // Wait until the queued block with this fence value is complete
+  void     dmaWaitFence(uint32_t fence);
+
   bool     DMA_Enabled = false;   // Flag for DMA enabled state
-  uint8_t  spiBusyCheck = 0;      // Number of ESP32 transfer buffers to check
+  uint16_t spiBusyCheck = 0;      // Number of ESP32 transfer buffers to check, 6 per queued block
 
   // Bare metal functions
   void     startWrite(void);                         // Begin SPI transaction
@@ -642,6 +781,12 @@ class TFT_eSPI : public Print {
            // Used for diagnostic sketch to see library setup adopted by compiler, see Section 7 above
   void     getSetup(setup_t& tft_settings); // Sketch provides the instance to populate
 
+           // Bus activity counters, only available if TFT_eSPI_STATS is defined, see Section 7 above
+           #ifdef TFT_eSPI_STATS
+  void     getStats(tftStats_t& tft_stats); // Sketch provides the instance to populate
+  void     resetStats(void);                // Set all counters to zero
+           #endif
+
   // Global variables
   static   SPIClass& getSPIinstance(void); // Get SPI class handle
 
@@ -690,6 +835,9 @@ class TFT_eSPI : public Print {
            // Byte read prototype
   uint8_t  readByte(void);
 
+           // Find a string in the width cache, or get an entry to store the width in
+  widthCache_t* findTextWidth(const char *string);
+
            // GPIO parallel bus input/output direction control
   void     busDir(uint32_t mask, uint8_t mode);
 
@@ -745,6 +893,34 @@ class TFT_eSPI : public Print {
 
   uint32_t _lastColor; // Buffered value of last colour used
 
+  // Draw a GFX free font string and its background as one block, used by drawString().
+  // Returns false if the string must be drawn character by character (Sprites)
+  virtual bool drawStringGFX(const char *string, int32_t x, int32_t y, int32_t bx, int32_t bw, int16_t *advance);
+
+  // Expand n bits of 1 bit per pixel data, starting at bit x of src, to 16 bit colours
+  void     expandBits(uint16_t *dst, const uint8_t *src, uint32_t x, uint32_t n, uint16_t fg, uint16_t bg, bool lsbFirst);
+
+  // Convert 8, 4 or 2 bit per pixel colours to 565 colours in bus byte order (pushed with swap
+  // bytes false), pal is a colour map already in bus byte order (8 bit pixels are 332 colours
+  // if pal is nullptr)
+  void     convert8bpp(uint16_t *dst, const uint8_t *src, uint32_t n, const uint16_t *pal = nullptr);
+  void     convert4bpp(uint16_t *dst, const uint8_t *src, uint32_t x, uint32_t n, const uint16_t *pal);
+  void     convert2bpp(uint16_t *dst, const uint8_t *src, uint32_t x, uint32_t n, const uint16_t *pal);
+
+  // Draw a 1 bit per pixel image with a background colour in one window, used by drawBitmap()
+  // and drawXBitmap(). Returns false if the image must be drawn pixel by pixel (Sprites)
+  virtual bool pushBitmap(int32_t x, int32_t y, const uint8_t *bitmap, int32_t w, int32_t h, uint16_t fgcolor, uint16_t bgcolor, bool lsbFirst);
+
+  widthCache_t *_widthCache; // TEXT_WIDTH_CACHE entries, allocated when first needed
+  uint32_t _widthTick;       // Count of width cache look ups
+  bool     _pinWidth;        // Keep strings measured now in the caches
+
+#ifdef TFT_eSPI_STATS
+  tftStats_t _stats;      // Bus activity counters
+  uint32_t   _statsStart; // Start time of write transaction being timed
+  bool       _statsBusy;  // Write transaction is being timed
+#endif
+
 #ifdef LOAD_GFXFF
   GFXfont  *gfxFont;
 #endif
@@ -773,4 +949,13 @@ class TFT_eSPI : public Print {
 // Load the Sprite Class
 #include "Extensions/Sprite.h"
 
+// Load the Text box Class
+#include "Extensions/TextBox.h"
+
+// Load the Number field Class
+#include "Extensions/NumberField.h"
+
+// Load the Band renderer Class
+#include "Extensions/BandRenderer.h"
+
 #endif // ends #ifndef _TFT_eSPIH_
@@ -0,0 +1,215 @@
+// This is a Processing sketch, see https://processing.org/ to download the IDE
+
+// The sketch converts a smooth font "*.vlw" file into a font atlas header file for the
+// TFT_eSPI library. The atlas is used in place from FLASH by loadFont(array), so no RAM
+// is allocated for the glyph metrics and the font loads almost instantly.
+
+// Copy the vlw file into the sketch "data" folder and set the fontFile name below. The
+// created "*.h" file is saved in the sketch "FontFiles" folder, press Ctrl+K to see that
+// folder location. Include the header in the Arduino sketch and load the font with:
+
+//   tft.loadFont(fontName);
+
+// Setting alphaBits to 4 halves the size of the glyph bitmaps with little visible loss.
+
+// https://github.com/Bodmer/TFT_eSPI
+
+// MIT licence applies, all text above must be included in derivative works
+
+
+// ###########################################################################################
+// #                  These are the values to change for a particular setup                  #
+//                                                                                           #
+String fontFile = "Final-Frontier28"; // Name of vlw file in data folder, without extension  #
+//                                                                                           #
+int alphaBits = 4; // Bits per pixel alpha value, 8 (same as vlw) or 4 (half size)           #
+//                                                                                           #
+// #                   End of the values to change for a particular setup                    #
+// ###########################################################################################
+
+byte[] vlw;   // vlw file contents
+byte[] atlas; // Font atlas being created
+
+int atlasSize = 0;
+
+void setup() {
+
+  vlw = loadBytes(fontFile + ".vlw");
+
+  if (vlw == null) {
+    System.err.println("ERROR: " + fontFile + ".vlw not found in sketch data folder!");
+    exit();
+    return;
+  }
+
+  // vlw header
+  int gCount  = readInt32(0);
+  int ascent  = readInt32(16);
+  int descent = readInt32(20);
+
+  // vlw glyph metrics, 7 x 32 bit values per glyph
+  int[] unicode  = new int[gCount];
+  int[] gHeight  = new int[gCount];
+  int[] gWidth   = new int[gCount];
+  int[] gAdvance = new int[gCount];
+  int[] gdY      = new int[gCount];
+  int[] gdX      = new int[gCount];
+  int[] vlwBitmap = new int[gCount];
+
+  int bitmapPtr = 24 + gCount * 28;
+
+  // Same metric calculations as the TFT_eSPI loadMetrics() function
+  int maxAscent  = ascent;
+  int maxDescent = descent;
+
+  for (int i = 0; i < gCount; i++) {
+    int p = 24 + i * 28;
+    unicode[i]  = readInt32(p) & 0xFFFF;
+    gHeight[i]  = readInt32(p + 4) & 0xFF;
+    gWidth[i]   = readInt32(p + 8) & 0xFF;
+    gAdvance[i] = readInt32(p + 12) & 0xFF;
+    gdY[i]      = (short)readInt32(p + 16);
+    gdX[i]      = (byte)readInt32(p + 20);
+
+    vlwBitmap[i] = bitmapPtr;
+    bitmapPtr += gWidth[i] * gHeight[i];
+
+    if ((gHeight[i] - gdY[i]) > maxDescent) {
+      if (((unicode[i] > 0x20) && (unicode[i] < 0xA0) && (unicode[i] != 0x7F)) || (unicode[i] > 0xFF)) {
+        maxDescent = gHeight[i] - gdY[i];
+      }
+    }
+  }
+
+  int yAdvance   = maxAscent + maxDescent;
+  int spaceWidth = (ascent + descent) * 2 / 7;
+
+  // Sort the glyphs into Unicode order so the library can binary search the codes
+  Integer[] order = new Integer[gCount];
+  for (int i = 0; i < gCount; i++) order[i] = i;
+  final int[] codes = unicode;
+  java.util.Arrays.sort(order, new java.util.Comparator<Integer>() {
+    public int compare(Integer a, Integer b) {
+      return codes[a] - codes[b];
+    }
+  }
+  );
+
+  // Size the atlas, the metrics are 12 bytes per glyph
+  int bitmapStart = 24 + gCount * 12;
+  bitmapStart = (bitmapStart + 3) & ~3;
+
+  int bitmapSize = 0;
+  for (int i = 0; i < gCount; i++) bitmapSize += glyphBytes(gWidth[i], gHeight[i]);
+
+  atlasSize = bitmapStart + bitmapSize;
+  atlas = new byte[atlasSize];
+
+  // Header
+  atlas[0] = 'T';
+  atlas[1] = 'F';
+  atlas[2] = 'A';
+  atlas[3] = (byte)alphaBits;
+  writeInt16(4, gCount);
+  writeInt16(6, yAdvance);
+  writeInt16(8, spaceWidth);
+  writeInt16(10, ascent);
+  writeInt16(12, descent);
+  writeInt16(14, maxAscent);
+  writeInt16(16, maxDescent);
+  writeInt16(18, 0);
+  writeInt32(20, atlasSize);
+
+  // Metric arrays
+  int pBitmap  = 24;
+  int pUnicode = pBitmap  + gCount * 4;
+  int pdY      = pUnicode + gCount * 2;
+  int pHeight  = pdY      + gCount * 2;
+  int pWidth   = pHeight  + gCount;
+  int pAdvance = pWidth   + gCount;
+  int pdX      = pAdvance + gCount;
+
+  int bitmap = bitmapStart;
+
+  for (int n = 0; n < gCount; n++) {
+    int i = order[n];
+
+    writeInt32(pBitmap + n * 4, bitmap);
+    writeInt16(pUnicode + n * 2, unicode[i]);
+    writeInt16(pdY + n * 2, gdY[i]);
+    atlas[pHeight + n]  = (byte)gHeight[i];
+    atlas[pWidth + n]   = (byte)gWidth[i];
+    atlas[pAdvance + n] = (byte)gAdvance[i];
+    atlas[pdX + n]      = (byte)gdX[i];
+
+    // Glyph bitmap
+    for (int y = 0; y < gHeight[i]; y++) {
+      for (int x = 0; x < gWidth[i]; x++) {
+        int alpha = vlw[vlwBitmap[i] + x + y * gWidth[i]] & 0xFF;
+        if (alphaBits == 8) {
+          atlas[bitmap + x + y * gWidth[i]] = (byte)alpha;
+        } else {
+          // Round to 4 bits, the library scales back with alpha * 0x11. Faint pixels
+          // are kept as transparent text (no background) draws any non-zero alpha
+          int a4 = (alpha + 8) / 17;
+          if ((alpha != 0) && (a4 == 0)) a4 = 1;
+          int p = bitmap + (x >> 1) + y * ((gWidth[i] + 1) >> 1);
+          if ((x & 1) == 0) atlas[p] = (byte)(a4 << 4);
+          else atlas[p] = (byte)(atlas[p] | a4);
+        }
+      }
+    }
+    bitmap += glyphBytes(gWidth[i], gHeight[i]);
+  }
+
+  // Write the header file
+  String arrayName = fontFile.replaceAll("[^A-Za-z0-9_]", "_");
+
+  PrintWriter output = createWriter("FontFiles/" + arrayName + ".h");
+
+  output.println("// Font atlas created from " + fontFile + ".vlw by the TFT_eSPI Create_atlas sketch");
+  output.println("// " + gCount + " glyphs, " + alphaBits + " bit alpha, " + atlasSize + " bytes");
+  output.println();
+  output.println("#include <pgmspace.h>");
+  output.println();
+  output.println("const uint8_t " + arrayName + "[] PROGMEM __attribute__((aligned(4))) = {");
+
+  for (int i = 0; i < atlasSize; i++) {
+    if ((i % 16) == 0) output.print("  ");
+    output.print("0x" + hex(atlas[i], 2) + ",");
+    if ((i % 16) == 15) output.println();
+  }
+  if ((atlasSize % 16) != 0) output.println();
+
+  output.println("};");
+  output.flush();
+  output.close();
+
+  println("Created FontFiles/" + arrayName + ".h, " + gCount + " glyphs, " + atlasSize + " bytes (vlw is " + vlw.length + " bytes)");
+
+  exit();
+}
+
+// Bytes needed for a glyph bitmap
+int glyphBytes(int w, int h) {
+  if (alphaBits == 8) return w * h;
+  return ((w + 1) >> 1) * h;
+}
+
+// vlw values are big endian
+int readInt32(int p) {
+  return ((vlw[p] & 0xFF) << 24) | ((vlw[p + 1] & 0xFF) << 16) | ((vlw[p + 2] & 0xFF) << 8) | (vlw[p + 3] & 0xFF);
+}
+
+// Atlas values are little endian
+void writeInt16(int p, int v) {
+  atlas[p]     = (byte)v;
+  atlas[p + 1] = (byte)(v >> 8);
+}
+
+void writeInt32(int p, int v) {
+  atlas[p]     = (byte)v;
+  atlas[p + 1] = (byte)(v >> 8);
+  atlas[p + 2] = (byte)(v >> 16);
+  atlas[p + 3] = (byte)(v >> 24);
+}
@@ -139,6 +139,11 @@ int  fontSize = 20;
 // Font size to use in the Processing sketch display window that pops up (can be different to above)
 int displayFontSize = 28;
 
+// Append a table of kerning pairs to the font file, used by the TFT_eSPI drawString() and
+// textWidth() functions. Older library versions ignore the table. The pairs are found by
+// checking every combination of characters so this is slow for fonts with many characters
+boolean kerning = true;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Next we specify which unicode blocks from the the Basic Multilingual Plane (BMP) are included in the final font file. //
 // Note: The ttf/otf font file MAY NOT contain all possible Unicode characters, refer to the fonts online documentation. //
@@ -503,8 +508,17 @@ void setup() {
   try {
     print("Saving to sketch FontFiles folder... ");
 
+    // A font with a kerning table is marked as vlw version 12 so the library knows to read
+    // the table, the version is ignored by older library versions
+    ByteArrayOutputStream vlw = new ByteArrayOutputStream();
+    font.save(vlw);
+    byte[] bytes = vlw.toByteArray();
+    byte[] kern = kerning ? kerningTable(font, charset) : null;
+    if (kern != null) bytes[7] = 12;
+
     OutputStream output = createOutput("FontFiles/" + fontName + str(fontSize) + ".vlw");
-    font.save(output);
+    output.write(bytes);
+    if (kern != null) output.write(kern);
     output.close();
 
     println("OK!");
@@ -521,3 +535,59 @@ void setup() {
     println("Doh! Failed to create the file");
   }
 }
+
+
+// Return the kerning table to append to the font file, or null if there are no pairs. Each
+// pair is saved as the two Unicode codes (left code in the top 16 bits) and the adjustment
+// to the cursor advance in pixels
+byte[] kerningTable(PFont font, char[] charset) throws IOException {
+
+  java.awt.Font awtFont = (java.awt.Font) font.getNative();
+
+  if (awtFont == null) {
+    println("Kerning is not available for this font");
+    return null;
+  }
+
+  java.util.Map<java.awt.font.TextAttribute, Object> attributes = new java.util.HashMap<java.awt.font.TextAttribute, Object>();
+  attributes.put(java.awt.font.TextAttribute.KERNING, java.awt.font.TextAttribute.KERNING_ON);
+  awtFont = awtFont.deriveFont(attributes);
+
+  java.awt.font.FontRenderContext frc = new java.awt.font.FontRenderContext(null, true, true);
+
+  // Advance of each character on its own
+  float[] advance = new float[charset.length];
+  for (int i = 0; i < charset.length; i++) {
+    advance[i] = new java.awt.font.TextLayout(String.valueOf(charset[i]), awtFont, frc).getAdvance();
+  }
+
+  // The kerning adjustment is the difference between the pair advance and the sum of advances
+  java.util.ArrayList<int[]> pairs = new java.util.ArrayList<int[]>();
+
+  for (int i = 0; i < charset.length; i++) {
+    for (int j = 0; j < charset.length; j++) {
+      String pair = String.valueOf(charset[i]) + String.valueOf(charset[j]);
+      int adjust = round(new java.awt.font.TextLayout(pair, awtFont, frc).getAdvance() - advance[i] - advance[j]);
+      if (adjust != 0) pairs.add(new int[] { charset[i], charset[j], adjust });
+    }
+  }
+
+  if (pairs.size() == 0) return null;
+
+  ByteArrayOutputStream table = new ByteArrayOutputStream();
+  DataOutputStream data = new DataOutputStream(table);
+
+  data.writeBytes("KERN");
+  data.writeInt(pairs.size());
+
+  for (int[] p : pairs) {
+    data.writeInt((p[0] << 16) | p[1]);
+    data.writeInt(p[2]);
+  }
+
+  data.flush();
+
+  println("Kerning pairs added = " + pairs.size());
+
+  return table.toByteArray();
+}
@@ -304,3 +304,8 @@
 // so changing it here has no effect
 
 // #define SUPPORT_TRANSACTIONS
+
+// Uncomment to count the bus activity and write time of the graphics functions,
+// read the counters with getStats(). Adds a small overhead so leave commented out
+// unless you are measuring rendering performance
+// #define TFT_eSPI_STATS
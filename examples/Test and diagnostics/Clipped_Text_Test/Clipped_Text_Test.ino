@@ -0,0 +1,97 @@
+/*
+ Test for text drawn partly off the edges of the screen
+
+ Each character string is first drawn fully on the screen and read back as
+ a reference. It is then drawn so it crosses a screen edge and the visible
+ pixels are compared with the reference. Fonts 2 and 4 are tested at text
+ sizes 1 and 2, with and without a background colour. Font 2 characters that
+ cross the right edge are not drawn, so that edge is only tested with font 4.
+
+ The results are printed to the serial port, one line per test. The display
+ must support reading (TFT_MISO connected) for the test to work.
+
+ When the library is built for a host computer with TFT_HOST defined the
+ sketch exits when the test is complete.
+
+ #########################################################################
+ ###### DON'T FORGET TO UPDATE THE User_Setup.h FILE IN THE LIBRARY ######
+ #########################################################################
+*/
+
+#include <TFT_eSPI.h> // Hardware-specific library
+
+TFT_eSPI tft = TFT_eSPI();
+
+uint16_t failures = 0;
+
+// Returns the number of visible pixels that differ from the reference
+uint32_t testClip(const char *str, uint8_t font, uint8_t size, bool opaque, int32_t x, int32_t y)
+{
+  tft.setTextFont(font);
+  tft.setTextSize(size);
+  tft.setTextColor(TFT_YELLOW, opaque ? TFT_BLUE : TFT_YELLOW);
+
+  int32_t w = tft.textWidth(str);
+  int32_t h = tft.fontHeight();
+
+  uint16_t *ref = (uint16_t *)malloc(w * h * 2);
+  if (!ref) return 0;
+
+  // Reference copy drawn fully on the screen
+  tft.fillScreen(TFT_BLACK);
+  tft.drawString(str, 10, 10);
+  for (int32_t j = 0; j < h; j++) {
+    for (int32_t i = 0; i < w; i++) ref[i + j * w] = tft.readPixel(10 + i, 10 + j);
+  }
+
+  tft.fillScreen(TFT_BLACK);
+  tft.drawString(str, x, y);
+
+  uint32_t diff = 0;
+  for (int32_t j = 0; j < h; j++) {
+    for (int32_t i = 0; i < w; i++) {
+      if ((x + i < 0) || (y + j < 0) || (x + i >= tft.width()) || (y + j >= tft.height())) continue;
+      if (tft.readPixel(x + i, y + j) != ref[i + j * w]) diff++;
+    }
+  }
+
+  free(ref);
+  return diff;
+}
+
+void setup(void) {
+  Serial.begin(115200);
+
+  tft.init();
+  tft.setRotation(0);
+
+  Serial.println("Font Size Opaque     X     Y  Differences");
+
+  int32_t xy[][2] = { {-12, 40}, {40, -10}, {tft.width() - 20, 40}, {40, tft.height() - 12} };
+
+  for (uint8_t font = 2; font <= 4; font += 2) {
+    for (uint8_t size = 1; size <= 2; size++) {
+      for (uint8_t opaque = 0; opaque <= 1; opaque++) {
+        for (uint8_t p = 0; p < 4; p++) {
+          if ((font == 2) && (p == 2)) continue;
+          uint32_t diff = testClip("W8", font, size, opaque, xy[p][0], xy[p][1]);
+          if (diff) failures++;
+
+          char line[64];
+          sprintf(line, "%4d %4d %6d %5d %5d  %6lu", font, size, opaque, (int)xy[p][0], (int)xy[p][1], (unsigned long)diff);
+          Serial.println(line);
+        }
+      }
+    }
+  }
+
+  Serial.print(failures ? "FAIL, tests with differences: " : "PASS, tests with differences: ");
+  Serial.println(failures);
+
+#ifdef TFT_HOST
+  exit(failures ? 1 : 0); // Nothing to watch on a host so finish here
+#endif
+}
+
+void loop() {
+}
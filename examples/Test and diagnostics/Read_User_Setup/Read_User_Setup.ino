@@ -147,6 +147,7 @@ void printProcessorName(void)
   if ( user.esp == 0x32)   Serial.println("ESP32");
   if ( user.esp == 0x32F)  Serial.println("STM32");
   if ( user.esp == 0x0000) Serial.println("Generic");
+  if ( user.esp == 0x0001) Serial.println("Host");
 }
 
 // Get pin name
@@ -0,0 +1,439 @@
+/*
+ Rendering benchmark for the TFT_eSPI library
+
+ Runs a fixed mix of graphics primitives, text in every font type and
+ Sprite pushes, then prints a table with one line per test. The drawing
+ is deterministic (no random numbers) so results can be compared between
+ library versions to check the effect of changes to the rendering code.
+
+ On a board only the CPU time in microseconds is reported, this depends on
+ the processor and SPI clock rate.
+
+ When the library is built for a host computer with TFT_HOST defined (see
+ the Tools/PlatformIO folder notes) the SPI bus is replaced by a model of
+ the TFT controller and the table also reports for each test:
+
+   Bytes   - number of bytes that would be sent over the bus
+   DC      - number of Data/Command line toggles (command switches)
+   Windows - number of GRAM write windows opened (RAMWR commands)
+   Addr    - number of column and row address commands (CASET + PASET)
+
+ These bus figures do not depend on the host processor speed so provide a
+ stable number that can be recorded for each commit. On the host the sketch
+ exits when the benchmark is complete so it can be run by a build server.
+
+ Fonts 1, 2, 4, 6, 7, 8, the FreeFonts and Smooth fonts are tested if they
+ are loaded in the setup file.
+
+ #########################################################################
+ ###### DON'T FORGET TO UPDATE THE User_Setup.h FILE IN THE LIBRARY ######
+ #########################################################################
+*/
+
+#include <TFT_eSPI.h>
+
+#ifdef SMOOTH_FONT
+  // The font is stored in FLASH as an array, see Smooth Font examples
+  #include "NotoSansBold15.h"
+#endif
+
+TFT_eSPI    tft = TFT_eSPI();
+TFT_eSprite spr = TFT_eSprite(&tft);
+
+uint32_t totalTime = 0;
+
+#ifdef TFT_HOST
+  busStats_t totalStats;
+  void printStats(busStats_t &stats);
+#endif
+
+// Prototypes are listed as host builds do not generate them automatically
+void runBenchmark(void);
+void testStart(void);
+void testEnd(const char *name);
+void printColumn(uint32_t value, uint8_t width);
+void testFillScreen(void);
+void testPixels(void);
+void testLines(void);
+void testFastLines(void);
+void testRects(void);
+void testFilledRects(void);
+void testFilledCircles(void);
+void testCircles(void);
+void testFilledTriangles(void);
+void testRoundRects(void);
+void testText(uint8_t font);
+void testNumbers(uint8_t font);
+void testFreeFont(void);
+void testSmoothFont(void);
+void testSprite(uint8_t bpp);
+
+// #########################################################################
+// Setup
+// #########################################################################
+void setup(void) {
+  Serial.begin(115200);
+
+  tft.init();
+  tft.setRotation(0);
+  tft.fillScreen(TFT_BLACK);
+
+#ifdef TFT_HOST
+  memset(&totalStats, 0, sizeof(totalStats));
+#endif
+
+  runBenchmark();
+
+#ifdef TFT_HOST
+  exit(0); // Nothing to watch on a host so finish here
+#endif
+}
+
+// #########################################################################
+// Loop
+// #########################################################################
+void loop() {
+  delay(10000);
+  runBenchmark();
+}
+
+// #########################################################################
+// Run all the tests and print the results table
+// #########################################################################
+void runBenchmark(void)
+{
+  totalTime = 0;
+
+  Serial.println();
+#ifdef TFT_HOST
+  Serial.println(F("Test               CPU us      Bytes        DC   Windows      Addr"));
+#else
+  Serial.println(F("Test               CPU us"));
+#endif
+
+  testStart(); testFillScreen();     testEnd("fillScreen");
+  testStart(); testPixels();         testEnd("drawPixel");
+  testStart(); testLines();          testEnd("drawLine");
+  testStart(); testFastLines();      testEnd("drawFastH/VLine");
+  testStart(); testRects();          testEnd("drawRect");
+  testStart(); testFilledRects();    testEnd("fillRect");
+  testStart(); testFilledCircles();  testEnd("fillCircle");
+  testStart(); testCircles();        testEnd("drawCircle");
+  testStart(); testFilledTriangles();testEnd("fillTriangle");
+  testStart(); testRoundRects();     testEnd("drawRoundRect");
+
+#ifdef LOAD_GLCD
+  testStart(); testText(1);          testEnd("Text font 1");
+#endif
+#ifdef LOAD_FONT2
+  testStart(); testText(2);          testEnd("Text font 2");
+#endif
+#ifdef LOAD_FONT4
+  testStart(); testText(4);          testEnd("Text font 4");
+#endif
+#ifdef LOAD_FONT6
+  testStart(); testNumbers(6);       testEnd("Text font 6");
+#endif
+#ifdef LOAD_FONT7
+  testStart(); testNumbers(7);       testEnd("Text font 7");
+#endif
+#ifdef LOAD_FONT8
+  testStart(); testNumbers(8);       testEnd("Text font 8");
+#endif
+#ifdef LOAD_GFXFF
+  testStart(); testFreeFont();       testEnd("Text FreeFont");
+#endif
+#ifdef SMOOTH_FONT
+  testStart(); testSmoothFont();     testEnd("Text Smooth font");
+#endif
+
+  testStart(); testSprite(16);       testEnd("pushSprite 16bpp");
+  testStart(); testSprite(8);        testEnd("pushSprite 8bpp");
+  testStart(); testSprite(4);        testEnd("pushSprite 4bpp");
+  testStart(); testSprite(1);        testEnd("pushSprite 1bpp");
+
+  Serial.print(F("Total            "));
+  printColumn(totalTime, 8);
+#ifdef TFT_HOST
+  printStats(totalStats);
+#endif
+  Serial.println();
+}
+
+// #########################################################################
+// Reset the counters and timer at the start of a test
+// #########################################################################
+uint32_t startTime = 0;
+
+void testStart(void)
+{
+  tft.fillScreen(TFT_BLACK);
+#ifdef TFT_HOST
+  TFT_eSPI::getSPIinstance().resetStats();
+#endif
+  startTime = micros();
+}
+
+// #########################################################################
+// Print the results at the end of a test
+// #########################################################################
+void testEnd(const char *name)
+{
+  uint32_t t = micros() - startTime;
+  totalTime += t;
+
+  Serial.print(name);
+  for (int32_t i = strlen(name); i < 17; i++) Serial.print(' ');
+  printColumn(t, 8);
+
+#ifdef TFT_HOST
+  busStats_t stats = TFT_eSPI::getSPIinstance().stats;
+  printStats(stats);
+
+  totalStats.bytes     += stats.bytes;
+  totalStats.dcToggles += stats.dcToggles;
+  totalStats.ramwr     += stats.ramwr;
+  totalStats.caset     += stats.caset;
+  totalStats.paset     += stats.paset;
+#endif
+
+  Serial.println();
+}
+
+#ifdef TFT_HOST
+void printStats(busStats_t &stats)
+{
+  printColumn(stats.bytes, 11);
+  printColumn(stats.dcToggles, 10);
+  printColumn(stats.ramwr, 10);
+  printColumn(stats.caset + stats.paset, 10);
+}
+#endif
+
+// Right justify a number in a column
+void printColumn(uint32_t value, uint8_t width)
+{
+  char str[12];
+  sprintf(str, "%lu", (unsigned long)value);
+  for (int32_t i = strlen(str); i < width; i++) Serial.print(' ');
+  Serial.print(str);
+}
+
+// #########################################################################
+// Graphics primitive tests, based on the TFT_graphicstest_PDQ sketch
+// #########################################################################
+void testFillScreen(void)
+{
+  tft.fillScreen(TFT_WHITE);
+  tft.fillScreen(TFT_RED);
+  tft.fillScreen(TFT_GREEN);
+  tft.fillScreen(TFT_BLUE);
+  tft.fillScreen(TFT_BLACK);
+}
+
+void testPixels(void)
+{
+  int32_t w = tft.width();
+  int32_t h = tft.height();
+
+  for (int32_t y = 0; y < h; y += 2)
+  {
+    for (int32_t x = 0; x < w; x += 3)
+    {
+      tft.drawPixel(x, y, tft.color565(x << 3, y << 3, x * y));
+    }
+  }
+}
+
+void testLines(void)
+{
+  int32_t w = tft.width();
+  int32_t h = tft.height();
+
+  for (int32_t x = 0; x < w; x += 6) tft.drawLine(0, 0, x, h - 1, TFT_CYAN);
+  for (int32_t y = 0; y < h; y += 6) tft.drawLine(0, 0, w - 1, y, TFT_CYAN);
+  for (int32_t x = 0; x < w; x += 6) tft.drawLine(w - 1, h - 1, x, 0, TFT_YELLOW);
+  for (int32_t y = 0; y < h; y += 6) tft.drawLine(w - 1, h - 1, 0, y, TFT_YELLOW);
+}
+
+void testFastLines(void)
+{
+  int32_t w = tft.width();
+  int32_t h = tft.height();
+
+  for (int32_t y = 0; y < h; y += 5) tft.drawFastHLine(0, y, w, TFT_RED);
+  for (int32_t x = 0; x < w; x += 5) tft.drawFastVLine(x, 0, h, TFT_BLUE);
+}
+
+void testRects(void)
+{
+  int32_t cx = tft.width()  / 2;
+  int32_t cy = tft.height() / 2;
+  int32_t n  = min(tft.width(), tft.height());
+
+  for (int32_t i = 2; i < n; i += 6)
+  {
+    int32_t i2 = i / 2;
+    tft.drawRect(cx - i2, cy - i2, i, i, TFT_GREEN);
+  }
+}
+
+void testFilledRects(void)
+{
+  int32_t cx = tft.width()  / 2 - 1;
+  int32_t cy = tft.height() / 2 - 1;
+  int32_t n  = min(tft.width(), tft.height());
+
+  for (int32_t i = n; i > 0; i -= 6)
+  {
+    int32_t i2 = i / 2;
+    tft.fillRect(cx - i2, cy - i2, i, i, tft.color565(i, i, 0));
+  }
+}
+
+void testFilledCircles(void)
+{
+  int32_t r = 10, r2 = r * 2;
+  int32_t w = tft.width();
+  int32_t h = tft.height();
+
+  for (int32_t x = r; x < w; x += r2)
+  {
+    for (int32_t y = r; y < h; y += r2)
+    {
+      tft.fillCircle(x, y, r, TFT_MAGENTA);
+    }
+  }
+}
+
+void testCircles(void)
+{
+  int32_t r = 10, r2 = r * 2;
+  int32_t w = tft.width()  + r;
+  int32_t h = tft.height() + r;
+
+  for (int32_t x = 0; x < w; x += r2)
+  {
+    for (int32_t y = 0; y < h; y += r2)
+    {
+      tft.drawCircle(x, y, r, TFT_WHITE);
+    }
+  }
+}
+
+void testFilledTriangles(void)
+{
+  int32_t cx = tft.width()  / 2 - 1;
+  int32_t cy = tft.height() / 2 - 1;
+  int32_t n  = min(cx, cy);
+
+  for (int32_t i = n; i > 10; i -= 5)
+  {
+    tft.fillTriangle(cx, cy - i, cx - i, cy + i, cx + i, cy + i, tft.color565(0, i, i));
+  }
+}
+
+void testRoundRects(void)
+{
+  int32_t cx = tft.width()  / 2 - 1;
+  int32_t cy = tft.height() / 2 - 1;
+  int32_t w  = min(tft.width(), tft.height());
+
+  for (int32_t i = 0; i < w; i += 6)
+  {
+    int32_t i2 = i / 2;
+    tft.drawRoundRect(cx - i2, cy - i2, i, i, i / 8, tft.color565(i, 0, 0));
+  }
+}
+
+// #########################################################################
+// Text tests
+// #########################################################################
+// Draw lines of text with a background colour, then with a transparent background
+void testText(uint8_t font)
+{
+  int32_t h = tft.height();
+
+  tft.setTextFont(font);
+  tft.setTextSize(1);
+  int32_t dy = tft.fontHeight();
+
+  tft.setTextColor(TFT_WHITE, TFT_BLUE);
+  for (int32_t y = 0; y < h / 2 - dy; y += dy) tft.drawString("The quick brown fox", 0, y);
+
+  tft.setTextColor(TFT_YELLOW);
+  for (int32_t y = h / 2; y < h - dy; y += dy) tft.drawString("jumps over 1234567890", 0, y);
+}
+
+// Fonts 6, 7 and 8 only contain numbers
+void testNumbers(uint8_t font)
+{
+  int32_t h = tft.height();
+
+  tft.setTextFont(font);
+  tft.setTextSize(1);
+  int32_t dy = tft.fontHeight();
+
+  tft.setTextColor(TFT_GREEN, TFT_BLACK);
+  for (int32_t y = 0; y < h - dy; y += dy) tft.drawNumber(1234 + y, 0, y);
+}
+
+#ifdef LOAD_GFXFF
+void testFreeFont(void)
+{
+  int32_t h = tft.height();
+
+  tft.setFreeFont(&FreeSans9pt7b);
+  tft.setTextSize(1);
+  int32_t dy = tft.fontHeight();
+
+  tft.setTextColor(TFT_WHITE);
+  for (int32_t y = 0; y < h - dy; y += dy) tft.drawString("The quick brown fox 123", 0, y);
+
+  tft.setFreeFont(NULL);
+}
+#endif
+
+#ifdef SMOOTH_FONT
+void testSmoothFont(void)
+{
+  int32_t h = tft.height();
+
+  tft.loadFont(NotoSansBold15);
+  int32_t dy = tft.fontHeight();
+
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  for (int32_t y = 0; y < h - dy; y += dy) tft.drawString("The quick brown fox 123", 0, y);
+
+  tft.unloadFont();
+}
+#endif
+
+// #########################################################################
+// Sprite push tests
+// #########################################################################
+// Draw a 64 x 64 Sprite then push it in a grid over the screen
+void testSprite(uint8_t bpp)
+{
+  spr.setColorDepth(bpp);
+  if (spr.createSprite(64, 64) == nullptr) return;
+
+  if (bpp == 4) spr.createPalette(default_4bit_palette);
+
+  spr.fillSprite(bpp == 4 ? 1 : TFT_NAVY);
+  spr.fillCircle(32, 32, 24, bpp == 4 ? 14 : TFT_YELLOW);
+  spr.drawRect(0, 0, 64, 64, bpp == 4 ? 15 : TFT_WHITE);
+
+  int32_t w = tft.width();
+  int32_t h = tft.height();
+
+  for (int32_t y = 0; y < h; y += 64)
+  {
+    for (int32_t x = 0; x < w; x += 64)
+    {
+      spr.pushSprite(x, y);
+    }
+  }
+
+  spr.deleteSprite();
+}